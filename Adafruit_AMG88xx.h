@@ -1,6 +1,7 @@
 #ifndef LIB_ADAFRUIT_AMG88XX_H
 #define LIB_ADAFRUIT_AMG88XX_H
 
+#if defined(ARDUINO)
 #if (ARDUINO >= 100)
 #include "Arduino.h"
 #else
@@ -8,6 +9,12 @@
 #endif
 
 #include <Adafruit_I2CDevice.h>
+#else
+#include "Adafruit_AMG88xx_Host.h"
+#endif
+
+#include "Adafruit_AMG88xx_BusStats.h"
+#include "Adafruit_AMG88xx_Profiler.h"
 
 /*=========================================================================
     I2C ADDRESS/BITS
@@ -39,6 +46,10 @@ enum {
   AMG88xx_PIXEL_OFFSET = 0x80
 };
 
+// the configuration registers, one bit per address: PCTL, FPSC, INTC, AVE
+// and the interrupt levels. RST and SCLR are commands, not settings.
+#define AMG88xx_CONFIG_REGS 0x3F8D
+
 enum power_modes {
   AMG88xx_NORMAL_MODE = 0x00,
   AMG88xx_SLEEP_MODE = 0x01,
@@ -57,24 +68,277 @@ enum int_modes { AMG88xx_DIFFERENCE = 0x00, AMG88xx_ABSOLUTE_VALUE = 0x01 };
 /*=========================================================================*/
 
 #define AMG88xx_PIXEL_ARRAY_SIZE 64
+#define AMG88xx_PIXEL_ROWS 8
+#define AMG88xx_PIXEL_COLS 8
 #define AMG88xx_PIXEL_TEMP_CONVERSION .25
 #define AMG88xx_THERMISTOR_CONVERSION .0625
 
+#define AMG88xx_CAL_GAIN_SHIFT 14
+#define AMG88xx_CAL_GAIN_ONE (1 << AMG88xx_CAL_GAIN_SHIFT)
+
 /**************************************************************************/
 /*!
-    @brief  Class that stores state and functions for interacting with AMG88xx
-   IR sensor chips
+    @brief  Per-pixel fixed pattern correction, applied to the raw counts as
+   (raw - offset) * gain. Tables can be generated from flat-field captures
+   with extras/tools/amg88xx_calibrate.cpp.
+*/
+/**************************************************************************/
+struct AMG88xx_Calibration {
+  int16_t offset[AMG88xx_PIXEL_ARRAY_SIZE]; ///< offset in raw counts
+  uint16_t gain[AMG88xx_PIXEL_ARRAY_SIZE];  ///< gain, AMG88xx_CAL_GAIN_ONE = 1
+};
+
+/**************************************************************************/
+/*!
+    @brief  Summary of a frame, gathered while the pixels are decoded. All
+   values are in raw counts of AMG88xx_PIXEL_TEMP_CONVERSION degrees C.
 */
 /**************************************************************************/
-class Adafruit_AMG88xx {
+struct AMG88xx_FrameStats {
+  int16_t minValue; ///< coldest pixel
+  int16_t maxValue; ///< hottest pixel
+  uint8_t minIndex; ///< index of the first coldest pixel
+  uint8_t maxIndex; ///< index of the first hottest pixel
+  uint8_t count;    ///< number of pixels summarized
+  int32_t sum;      ///< sum of the pixels
+  uint32_t sumSq;   ///< sum of the squared pixels
+
+  /*! @brief start a new summary */
+  void reset() {
+    minValue = 0x7FFF;
+    maxValue = -0x8000;
+    count = 0;
+    sum = 0;
+    sumSq = 0;
+  }
+
+  /*!
+      @brief  add one pixel to the summary
+      @param  i the pixel index
+      @param  v the pixel value
+  */
+  void add(uint8_t i, int16_t v) {
+    if (v < minValue) {
+      minValue = v;
+      minIndex = i;
+    }
+    if (v > maxValue) {
+      maxValue = v;
+      maxIndex = i;
+    }
+    count++;
+    sum += v;
+    sumSq += (int32_t)v * v;
+  }
+
+  /*! @brief mean of the pixels @returns the mean in raw counts */
+  float mean() const { return count ? (float)sum / count : 0; }
+
+  /*! @brief variance of the pixels @returns the variance in raw counts^2 */
+  float variance() const {
+    float m = mean();
+    return count ? (float)sumSq / count - m * m : 0;
+  }
+};
+
+/**************************************************************************/
+/*!
+    @brief  A frame exactly as the sensor's registers hold it, for storing or
+   sending on without decoding
+*/
+/**************************************************************************/
+struct AMG88xx_RawFrame {
+  uint8_t thermistor[2];                         ///< TTHL and TTHH
+  uint8_t pixels[AMG88xx_PIXEL_ARRAY_SIZE << 1]; ///< pixel registers, L then H
+
+  /*!
+      @brief  decode one pixel, without calibration
+      @param  i the pixel index
+      @returns the pixel in raw counts of AMG88xx_PIXEL_TEMP_CONVERSION
+  */
+  int16_t pixel(uint8_t i) const {
+    uint16_t v = ((uint16_t)pixels[(i << 1) + 1] << 8) | pixels[i << 1];
+    return (int16_t)(v << 4) >> 4;
+  }
+
+  /*!
+      @brief  decode the thermistor
+      @returns the board temperature in raw counts of
+     AMG88xx_THERMISTOR_CONVERSION
+  */
+  int16_t thermistorRaw() const {
+    int16_t mag = ((thermistor[1] & 0x07) << 8) | thermistor[0];
+    return (thermistor[1] & 0x08) ? -mag : mag;
+  }
+};
+
+/**************************************************************************/
+/*!
+    @brief  The control and status registers 0x00 to 0x0F, as read in one
+   burst by Adafruit_AMG88xx::readRegisterSnapshot(). RST and SCLR are write
+   only and read as 0.
+*/
+/**************************************************************************/
+struct AMG88xx_RegisterSnapshot {
+  uint8_t regs[AMG88xx_TTHH + 1]; ///< registers, indexed by address
+
+  /*! @brief the power mode @returns one of power_modes */
+  uint8_t powerMode() const { return regs[AMG88xx_PCTL]; }
+  /*! @brief the frame rate @returns one of frame_rates */
+  uint8_t frameRate() const { return regs[AMG88xx_FPSC] & 0x01; }
+  /*! @brief whether the INT pin is driven @returns True if enabled */
+  bool interruptEnabled() const { return regs[AMG88xx_INTC] & 0x01; }
+  /*! @brief the interrupt mode @returns one of int_modes */
+  uint8_t interruptMode() const { return (regs[AMG88xx_INTC] >> 1) & 0x01; }
+  /*! @brief whether twice moving average is on @returns True if on */
+  bool movingAverage() const { return regs[AMG88xx_AVE] & 0x20; }
+
+  /*! @brief whether a pixel has interrupted @returns STAT.INTF */
+  bool interruptFlag() const { return regs[AMG88xx_STAT] & 0x02; }
+  /*! @brief whether a pixel overflowed @returns STAT.OVF_IRS */
+  bool pixelOverflow() const { return regs[AMG88xx_STAT] & 0x04; }
+  /*! @brief whether the thermistor overflowed @returns STAT.OVF_THS */
+  bool thermistorOverflow() const { return regs[AMG88xx_STAT] & 0x08; }
+
+  /*!
+      @brief  the upper interrupt level
+      @returns the level in raw counts of AMG88xx_PIXEL_TEMP_CONVERSION
+  */
+  int16_t interruptHighRaw() const { return level(AMG88xx_INTHL); }
+  /*!
+      @brief  the lower interrupt level
+      @returns the level in raw counts of AMG88xx_PIXEL_TEMP_CONVERSION
+  */
+  int16_t interruptLowRaw() const { return level(AMG88xx_INTLL); }
+  /*!
+      @brief  the interrupt hysteresis
+      @returns the level in raw counts of AMG88xx_PIXEL_TEMP_CONVERSION
+  */
+  int16_t hysteresisRaw() const { return level(AMG88xx_IHYSL); }
+
+  /*!
+      @brief  decode the thermistor
+      @returns the board temperature in raw counts of
+     AMG88xx_THERMISTOR_CONVERSION
+  */
+  int16_t thermistorRaw() const {
+    int16_t mag = ((regs[AMG88xx_TTHH] & 0x07) << 8) | regs[AMG88xx_TTHL];
+    return (regs[AMG88xx_TTHH] & 0x08) ? -mag : mag;
+  }
+
+private:
+  // 12 bit two's complement level, L then H
+  int16_t level(uint8_t reg) const {
+    uint16_t v = ((uint16_t)regs[reg + 1] << 8) | regs[reg];
+    return (int16_t)(v << 4) >> 4;
+  }
+};
+
+/**************************************************************************/
+/*!
+    @brief  A complete sensor configuration that can be written to one or many
+   sensors with as few register writes as possible
+*/
+/**************************************************************************/
+struct AMG88xx_Profile {
+  uint8_t powerMode = AMG88xx_NORMAL_MODE;    ///< one of power_modes
+  uint8_t frameRate = AMG88xx_FPS_10;         ///< one of frame_rates
+  bool movingAverage = false;                 ///< twice moving average mode
+  uint8_t interruptMode = AMG88xx_DIFFERENCE; ///< one of int_modes
+  bool interruptEnable = false;               ///< drive the INT pin
+  float interruptHigh = 0;                    ///< upper level in degrees C
+  float interruptLow = 0;                     ///< lower level in degrees C
+  float interruptHysteresis = 0;              ///< hysteresis in degrees C
+};
+
+/**************************************************************************/
+/*!
+    @brief  Bus policy reaching the sensor through an Adafruit BusIO I2C
+   device, the transport of Adafruit_AMG88xx.
+
+   A bus policy is any class with begin(...), read(), write(), delay() and
+   maxTransfer() members shaped like these. The driver holds one by value
+   and calls it directly, so swapping transports costs no virtual dispatch.
+
+   The I2C device is held inline and reassigned by begin(), so the driver
+   never touches the heap and calling begin() again to recover from a bus
+   fault takes the same time and memory every time.
+*/
+/**************************************************************************/
+class AMG88xx_I2CDeviceBus {
 public:
-  // constructors
-  Adafruit_AMG88xx(void){};
-  ~Adafruit_AMG88xx(void){};
+  AMG88xx_I2CDeviceBus(void) : i2c_dev(AMG88xx_ADDRESS, &Wire) {}
 
   bool begin(uint8_t addr = AMG88xx_ADDRESS, TwoWire *theWire = &Wire);
+  bool read(uint8_t reg, uint8_t *buf, uint8_t num);
+  bool write(uint8_t reg, const uint8_t *buf, uint8_t num);
+
+  /*! @brief wait for the sensor @param ms the time in milliseconds */
+  void delay(uint32_t ms) { ::delay(ms); }
+
+  /*! @brief largest read done in one transfer @returns the size in bytes */
+  uint8_t maxTransfer() { return min(i2c_dev.maxBufferSize(), (size_t)255); }
+
+private:
+  Adafruit_I2CDevice i2c_dev; ///< I2C bus interface
+};
+
+/*=========================================================================
+    STACK USE
+    -----------------------------------------------------------------------
+    Every buffer in the driver is sized at compile time, so stack use has a
+    static bound. Besides a few bytes of locals, the driver needs:
+
+      readPixels, readPixelsRaw, readStats  a 128 byte register buffer
+      readRawFrame, readThermistor,         nothing, registers are read
+      getInterrupt, readRegisterSnapshot    straight into the result
+      apply                                 a 14 byte register image, and a
+                                            16 byte snapshot to verify
+
+    AMG88xx_I2CDeviceBus reads each chunk straight into the destination,
+    so the bus adds no buffer. extras/tools/amg88xx_stack.cpp reports the
+    worst case of every function for any GCC toolchain. Measured with
+    x86-64 GCC 12 at -O2, through the host shim, in bytes:
+
+      readPixels, readPixelsRaw, readStats  424
+      apply                                 376
+      readRawFrame, readThermistor,         280
+      readRegisterSnapshot
+      getInterrupt                          256
+      setters such as setMovingAverageMode  216
+
+    These stop at the bus: Wire, and any other code built without a call
+    graph, is not counted, so add the Wire library's own use on the target.
+    -----------------------------------------------------------------------*/
 
-  void readPixels(float *buf, uint8_t size = AMG88xx_PIXEL_ARRAY_SIZE);
+/**************************************************************************/
+/*!
+    @brief  Class that stores state and functions for interacting with AMG88xx
+   IR sensor chips over any bus policy
+*/
+/**************************************************************************/
+template <class Bus> class Adafruit_AMG88xx_Driver {
+public:
+  // constructors
+  Adafruit_AMG88xx_Driver(void){};
+  ~Adafruit_AMG88xx_Driver(void){};
+
+  template <typename... Args> bool begin(Args... args);
+
+  template <typename Arg, typename... Rest>
+  static uint32_t beginAll(Adafruit_AMG88xx_Driver *const *sensors,
+                           const Arg *args, uint8_t count,
+                           const AMG88xx_Profile &profile, Rest... rest);
+  bool apply(const AMG88xx_Profile &profile, bool verify = false);
+
+  void readPixels(float *buf, uint8_t size = AMG88xx_PIXEL_ARRAY_SIZE,
+                  AMG88xx_FrameStats *stats = NULL);
+  void readPixelsRaw(int16_t *buf, uint8_t size = AMG88xx_PIXEL_ARRAY_SIZE,
+                     AMG88xx_FrameStats *stats = NULL);
+  void readStats(AMG88xx_FrameStats *stats);
+  bool readRawFrame(AMG88xx_RawFrame *frame);
+  bool readRegisterSnapshot(AMG88xx_RegisterSnapshot *snapshot);
+  void setCalibration(const AMG88xx_Calibration *cal);
   float readThermistor();
 
   void setMovingAverageMode(bool mode);
@@ -91,18 +355,42 @@ public:
   // this will manually set hysteresis
   void setInterruptLevels(float high, float low, float hysteresis);
 
+  /*! @brief the transport @returns the bus policy instance */
+  Bus &bus() { return _bus; }
+
+#if defined(AMG88xx_BUS_STATS)
+  /*! @brief bus counters since begin() @returns the counters */
+  const AMG88xx_BusStats &busStats() const { return _busStats; }
+  /*! @brief zero the bus counters */
+  void resetBusStats() { _busStats.reset(); }
+#endif
+
 private:
-  Adafruit_I2CDevice *i2c_dev = NULL; ///< Pointer to I2C bus interface
+  Bus _bus;                               ///< the transport
+  const AMG88xx_Calibration *_cal = NULL; ///< Optional pixel correction
+#if defined(AMG88xx_BUS_STATS)
+  AMG88xx_BusStats _busStats = AMG88xx_BusStats(); ///< bus counters
+#endif
+
+  // what the configuration registers were last written or read as, for
+  // the registers flagged in _known
+  uint8_t _regs[AMG88xx_TTHL];
+  uint16_t _known = 0;
+
+  bool resetDevice();
+  bool update(const uint8_t *want, uint8_t first, uint8_t last);
+  static uint8_t configMask(uint8_t reg);
+  static uint16_t levelToRaw(float level);
 
   void write8(byte reg, byte value);
   void write16(byte reg, uint16_t value);
   uint8_t read8(byte reg);
 
-  void read(uint8_t reg, uint8_t *buf, uint8_t num);
-  void write(uint8_t reg, uint8_t *buf, uint8_t num);
+  bool read(uint8_t reg, uint8_t *buf, uint8_t num);
+  bool write(uint8_t reg, const uint8_t *buf, uint8_t num);
 
   float signedMag12ToFloat(uint16_t val);
-  float int12ToFloat(uint16_t val);
+  int16_t decodePixel(const uint8_t *raw, uint8_t i);
 
   // The power control register
   struct pctl {
@@ -295,4 +583,11 @@ private:
   */
 };
 
-#endif
\ No newline at end of file
+/*!
+    @brief  The AMG88xx driver on an Adafruit BusIO I2C device
+*/
+typedef Adafruit_AMG88xx_Driver<AMG88xx_I2CDeviceBus> Adafruit_AMG88xx;
+
+#include "Adafruit_AMG88xx_Impl.h"
+
+#endif
@@ -0,0 +1,91 @@
+#include "Adafruit_AMG88xx_Background.h"
+
+// the largest shift of the 32 bit mean and variance accumulators
+#define MAX_SHIFT 31
+
+/**************************************************************************/
+/*!
+    @brief  Create a background model
+    @param  learnShift the background adapts by 1 / 2^learnShift of the
+   difference every frame. Default is 5, about 3 seconds at 10 FPS; at
+   most 31.
+    @param  thresholdSq a pixel is foreground when its squared difference
+   from the mean exceeds thresholdSq times the variance. Default is 9, or
+   3 sigma.
+    @param  minVariance the variance floor in 1/256ths of a raw count
+   squared, which keeps noise-free pixels from triggering on single count
+   changes. Default is 256, or 1 count squared.
+*/
+/**************************************************************************/
+AMG88xx_Background::AMG88xx_Background(uint8_t learnShift,
+                                       uint8_t thresholdSq,
+                                       uint16_t minVariance)
+    : _learnShift(min(learnShift, (uint8_t)MAX_SHIFT)), _absorbShift(0),
+      _thresholdSq(thresholdSq), _minVar(minVariance) {}
+
+/**************************************************************************/
+/*!
+    @brief  Forget the background. The next frame passed to update() becomes
+   the new background.
+*/
+/**************************************************************************/
+void AMG88xx_Background::reset() {
+  _primed = false;
+  _foreground = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Let foreground pixels slowly become background, for objects that
+   are moved into the scene and stay there
+    @param  shift foreground pixels adapt 2^shift times slower than
+   background pixels. 0, the default, never adapts foreground pixels.
+   Together with the learn shift it is capped at 31.
+*/
+/**************************************************************************/
+void AMG88xx_Background::setAbsorbShift(uint8_t shift) { _absorbShift = shift; }
+
+/**************************************************************************/
+/*!
+    @brief  Classify a frame and update the background with it
+    @param  raw a raw frame from Adafruit_AMG88xx::readPixelsRaw
+    @returns the foreground mask
+*/
+/**************************************************************************/
+uint64_t AMG88xx_Background::update(const int16_t *raw) {
+  if (!_primed) {
+    for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++) {
+      _mean[i] = (int32_t)raw[i] << 12;
+      _var[i] = _minVar;
+    }
+    _primed = true;
+    _foreground = 0;
+    return 0;
+  }
+
+  uint64_t mask = 0;
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++) {
+    int32_t diff = ((int32_t)raw[i] << 12) - _mean[i];
+    // squared difference in the 8 fraction bit variance units
+    uint32_t absDiff = min((uint32_t)((diff < 0 ? -diff : diff) >> 4),
+                           (uint32_t)0xFFFF);
+    uint32_t diffSq = (absDiff * absDiff) >> 8;
+    uint16_t var = max(_var[i], _minVar);
+    uint8_t shift = _learnShift;
+
+    if (diffSq > (uint32_t)_thresholdSq * var) {
+      mask |= (uint64_t)1 << i;
+      if (!_absorbShift)
+        continue;
+      // shifting the 32 bit accumulators by 32 or more is undefined
+      shift = min((uint16_t)(shift + _absorbShift), (uint16_t)MAX_SHIFT);
+    }
+
+    _mean[i] += diff >> shift;
+    int32_t varDiff = (int32_t)min(diffSq, (uint32_t)0xFFFF) - _var[i];
+    _var[i] += varDiff >> shift;
+  }
+
+  _foreground = mask;
+  return mask;
+}
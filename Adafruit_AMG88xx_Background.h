@@ -0,0 +1,55 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_BACKGROUND_H
+#define LIB_ADAFRUIT_AMG88XX_BACKGROUND_H
+
+#include "Adafruit_AMG88xx.h"
+
+/**************************************************************************/
+/*!
+    @brief  Per-pixel running mean and variance of the background, used to
+   split each raw frame into foreground and background. Only background
+   pixels update the model, so people standing still are not learned away.
+
+   Foreground masks have bit n set for pixel n, pixels counted row by row
+   as returned by Adafruit_AMG88xx::readPixelsRaw.
+*/
+/**************************************************************************/
+class AMG88xx_Background {
+public:
+  AMG88xx_Background(uint8_t learnShift = 5, uint8_t thresholdSq = 9,
+                     uint16_t minVariance = 256);
+
+  void reset();
+  uint64_t update(const int16_t *raw);
+
+  void setAbsorbShift(uint8_t shift);
+
+  /*! @brief the foreground mask of the last frame @returns the mask */
+  uint64_t foreground() const { return _foreground; }
+
+  /*!
+      @brief  background estimate for one pixel
+      @param  i the pixel index
+      @returns the mean in raw counts
+  */
+  int16_t mean(uint8_t i) const { return (_mean[i] + 2048) >> 12; }
+
+  /*!
+      @brief  background noise estimate for one pixel
+      @param  i the pixel index
+      @returns the variance in 1/256ths of a raw count squared
+  */
+  uint16_t variance(uint8_t i) const { return _var[i]; }
+
+private:
+  int32_t _mean[AMG88xx_PIXEL_ARRAY_SIZE]; // raw counts, 12 fraction bits
+  uint16_t _var[AMG88xx_PIXEL_ARRAY_SIZE]; // raw counts^2, 8 fraction bits
+  uint64_t _foreground = 0;
+
+  uint8_t _learnShift;  // background learns at 1 / 2^_learnShift per frame
+  uint8_t _absorbShift; // extra slowdown for foreground, 0 never learns it
+  uint8_t _thresholdSq; // foreground above sqrt(_thresholdSq) sigma
+  uint16_t _minVar;     // variance floor, same units as _var
+  bool _primed = false;
+};
+
+#endif
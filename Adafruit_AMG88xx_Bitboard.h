@@ -0,0 +1,57 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_BITBOARD_H
+#define LIB_ADAFRUIT_AMG88XX_BITBOARD_H
+
+#include <stdint.h>
+
+/*=========================================================================
+    PIXEL MASKS
+    -----------------------------------------------------------------------
+    An 8x8 frame fits in a uint64_t with bit n for pixel n, counted row by
+    row like the pixel registers. Byte y holds row y, bit x of that byte
+    holds column x.
+    -----------------------------------------------------------------------*/
+#define AMG88xx_MASK_ALL 0xFFFFFFFFFFFFFFFFULL
+#define AMG88xx_MASK_NOT_COL0 0xFEFEFEFEFEFEFEFEULL
+#define AMG88xx_MASK_NOT_COL7 0x7F7F7F7F7F7F7F7FULL
+/*=========================================================================*/
+
+/*!
+    @brief  count the pixels set in a mask
+    @param  mask the pixel mask
+    @returns the number of set pixels
+*/
+static inline uint8_t AMG88xx_maskCount(uint64_t mask) {
+  return __builtin_popcountll(mask);
+}
+
+/*!
+    @brief  index of the lowest set pixel in a mask
+    @param  mask the pixel mask, must not be 0
+    @returns the pixel index
+*/
+static inline uint8_t AMG88xx_maskFirst(uint64_t mask) {
+  return __builtin_ctzll(mask);
+}
+
+/*!
+    @brief  grow a mask by one pixel left, right, up and down
+    @param  mask the pixel mask
+    @returns the grown mask
+*/
+static inline uint64_t AMG88xx_maskDilate4(uint64_t mask) {
+  return mask | ((mask << 1) & AMG88xx_MASK_NOT_COL0) |
+         ((mask >> 1) & AMG88xx_MASK_NOT_COL7) | (mask << 8) | (mask >> 8);
+}
+
+/*!
+    @brief  grow a mask by one pixel in all eight directions
+    @param  mask the pixel mask
+    @returns the grown mask
+*/
+static inline uint64_t AMG88xx_maskDilate8(uint64_t mask) {
+  uint64_t row = mask | ((mask << 1) & AMG88xx_MASK_NOT_COL0) |
+                 ((mask >> 1) & AMG88xx_MASK_NOT_COL7);
+  return row | (row << 8) | (row >> 8);
+}
+
+#endif
@@ -0,0 +1,99 @@
+#include "Adafruit_AMG88xx_Blobs.h"
+
+/**************************************************************************/
+/*!
+    @brief  Create a blob finder
+    @param  eightConnected if True, diagonal neighbours join blobs. If False
+   only pixels sharing an edge do.
+    @param  minArea blobs with fewer pixels are dropped
+*/
+/**************************************************************************/
+AMG88xx_BlobFinder::AMG88xx_BlobFinder(bool eightConnected, uint8_t minArea)
+    : _eight(eightConnected), _minArea(minArea) {}
+
+/**************************************************************************/
+/*!
+    @brief  Label the blobs in a mask
+    @param  mask the foreground mask, see Adafruit_AMG88xx_Bitboard.h
+    @param  raw the raw frame the mask was made from, used for the centroid
+   and temperatures
+    @returns the number of blobs found, up to AMG88xx_MAX_BLOBS
+*/
+/**************************************************************************/
+uint8_t AMG88xx_BlobFinder::find(uint64_t mask, const int16_t *raw) {
+  _count = 0;
+
+  while (mask && _count < AMG88xx_MAX_BLOBS) {
+    // seed with the lowest pixel and grow until it stops changing
+    uint64_t blob = mask & (~mask + 1);
+    uint64_t prev;
+    do {
+      prev = blob;
+      blob = (_eight ? AMG88xx_maskDilate8(blob) : AMG88xx_maskDilate4(blob)) &
+             mask;
+    } while (blob != prev);
+
+    mask &= ~blob;
+
+    if (AMG88xx_maskCount(blob) < _minArea)
+      continue;
+
+    _blobs[_count].mask = blob;
+    measure(&_blobs[_count], raw);
+    _count++;
+  }
+
+  return _count;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill in the size, bounds, centroid and temperatures of a blob
+    @param  blob the blob, with its mask set
+    @param  raw the raw frame
+*/
+/**************************************************************************/
+void AMG88xx_BlobFinder::measure(AMG88xx_Blob *blob, const int16_t *raw) {
+  uint64_t mask = blob->mask;
+  blob->area = AMG88xx_maskCount(mask);
+
+  // bounds straight from the row bytes and their union
+  uint8_t cols = 0;
+  blob->minY = 0xFF;
+  for (uint8_t y = 0; y < AMG88xx_PIXEL_ROWS; y++) {
+    uint8_t row = mask >> (y << 3);
+    if (!row)
+      continue;
+    if (blob->minY == 0xFF)
+      blob->minY = y;
+    blob->maxY = y;
+    cols |= row;
+  }
+  // unsigned is 16 bits on AVR, so count from its actual width
+  blob->minX = __builtin_ctz(cols);
+  blob->maxX = (sizeof(unsigned) * 8 - 1) - __builtin_clz(cols);
+
+  int16_t lowest = raw[AMG88xx_maskFirst(mask)];
+  int16_t peak = lowest;
+  int32_t sum = 0;
+  for (uint64_t m = mask; m; m &= m - 1) {
+    int16_t v = raw[AMG88xx_maskFirst(m)];
+    lowest = min(lowest, v);
+    peak = max(peak, v);
+    sum += v;
+  }
+  blob->peak = peak;
+  blob->mean = sum / blob->area;
+
+  // weight each pixel by how far it is above the coolest pixel in the blob
+  uint32_t weight = 0, wx = 0, wy = 0;
+  for (uint64_t m = mask; m; m &= m - 1) {
+    uint8_t i = AMG88xx_maskFirst(m);
+    uint16_t w = raw[i] - lowest + 1;
+    weight += w;
+    wx += (uint32_t)w * (i & 0x07);
+    wy += (uint32_t)w * (i >> 3);
+  }
+  blob->x = (wx << 8) / weight;
+  blob->y = (wy << 8) / weight;
+}
@@ -0,0 +1,61 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_BLOBS_H
+#define LIB_ADAFRUIT_AMG88XX_BLOBS_H
+
+#include "Adafruit_AMG88xx.h"
+#include "Adafruit_AMG88xx_Bitboard.h"
+
+#ifndef AMG88xx_MAX_BLOBS
+#define AMG88xx_MAX_BLOBS 8
+#endif
+
+/**************************************************************************/
+/*!
+    @brief  One connected group of pixels
+*/
+/**************************************************************************/
+struct AMG88xx_Blob {
+  uint64_t mask; ///< the pixels in the blob
+  uint8_t area;  ///< number of pixels
+  uint8_t minX;  ///< leftmost column
+  uint8_t minY;  ///< top row
+  uint8_t maxX;  ///< rightmost column
+  uint8_t maxY;  ///< bottom row
+  uint16_t x;    ///< temperature weighted centroid column, in 1/256 pixels
+  uint16_t y;    ///< temperature weighted centroid row, in 1/256 pixels
+  int16_t peak;  ///< hottest pixel in raw counts
+  int16_t mean;  ///< mean of the pixels in raw counts
+};
+
+/**************************************************************************/
+/*!
+    @brief  Labels connected groups of pixels in a foreground mask. Each
+   group is found by repeatedly dilating a seed pixel within the mask, so
+   labeling costs a handful of 64-bit operations per blob.
+*/
+/**************************************************************************/
+class AMG88xx_BlobFinder {
+public:
+  AMG88xx_BlobFinder(bool eightConnected = true, uint8_t minArea = 1);
+
+  uint8_t find(uint64_t mask, const int16_t *raw);
+
+  /*! @brief number of blobs found by the last find() @returns the count */
+  uint8_t count() const { return _count; }
+
+  /*!
+      @brief  a blob found by the last find()
+      @param  i the blob index, less than count()
+      @returns the blob
+  */
+  const AMG88xx_Blob &blob(uint8_t i) const { return _blobs[i]; }
+
+private:
+  void measure(AMG88xx_Blob *blob, const int16_t *raw);
+
+  AMG88xx_Blob _blobs[AMG88xx_MAX_BLOBS];
+  uint8_t _count = 0;
+  bool _eight;
+  uint8_t _minArea;
+};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_BUSSTATS_H
+#define LIB_ADAFRUIT_AMG88XX_BUSSTATS_H
+
+/*=========================================================================
+    BUS STATISTICS
+    -----------------------------------------------------------------------
+    Define AMG88xx_BUS_STATS in the build flags, or before the first
+    include of Adafruit_AMG88xx.h in a sketch, and every sensor counts
+    what its register reads and writes cost on the bus. Read the counters
+    with busStats() before and after any call to see what it did.
+
+    Failed transfers are retried AMG88xx_BUS_RETRIES times, whether or not
+    statistics are kept.
+    -----------------------------------------------------------------------*/
+
+#ifndef AMG88xx_BUS_RETRIES
+#define AMG88xx_BUS_RETRIES 0 ///< extra attempts after a failed transfer
+#endif
+
+#define AMG88xx_BUS_HISTOGRAM_BUCKETS 16
+
+/**************************************************************************/
+/*!
+    @brief  Counters for one kind of bus operation. Latencies go into log2
+   buckets: bucket 0 holds calls under 1 us, bucket n calls of 2^(n-1) to
+   2^n - 1 us, and the last bucket everything slower.
+*/
+/**************************************************************************/
+struct AMG88xx_BusOpStats {
+  uint32_t calls;   ///< register accesses, including retries
+  uint32_t bytes;   ///< register bytes moved
+  uint32_t chunks;  ///< transfers the accesses were split into
+  uint32_t errors;  ///< failed attempts
+  uint32_t retries; ///< attempts repeated after a failure
+  uint32_t histogram[AMG88xx_BUS_HISTOGRAM_BUCKETS]; ///< latency buckets
+
+  /*!
+      @brief  count one attempt
+      @param  num bytes in the access
+      @param  chunks transfers it took
+      @param  ok whether it succeeded
+      @param  retry whether it repeated a failed attempt
+      @param  us how long it took in microseconds
+  */
+  void add(uint8_t num, uint8_t chunks, bool ok, bool retry, uint32_t us) {
+    calls++;
+    bytes += num;
+    this->chunks += chunks;
+    if (!ok)
+      errors++;
+    if (retry)
+      retries++;
+
+    uint8_t bucket = 0;
+    while (us && bucket < AMG88xx_BUS_HISTOGRAM_BUCKETS - 1) {
+      us >>= 1;
+      bucket++;
+    }
+    histogram[bucket]++;
+  }
+};
+
+/**************************************************************************/
+/*!
+    @brief  Bus counters of one sensor
+*/
+/**************************************************************************/
+struct AMG88xx_BusStats {
+  AMG88xx_BusOpStats read;  ///< register reads
+  AMG88xx_BusOpStats write; ///< register writes
+
+  /*! @brief zero every counter */
+  void reset() { memset(this, 0, sizeof(*this)); }
+};
+
+#endif
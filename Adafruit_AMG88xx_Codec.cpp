@@ -0,0 +1,217 @@
+#include "Adafruit_AMG88xx_Codec.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// unary prefixes this long switch to a raw 13 bit value
+#define ESCAPE 16
+#define ESCAPE_BITS 13
+
+// the adaptive Rice parameter of LOCO-I: the smallest k with n << k >= a
+struct RiceState {
+  uint32_t a = 8; // sum of recent mapped residuals
+  uint8_t n = 1;  // number of them
+
+  uint8_t k() const {
+    uint8_t k = 0;
+    while (((uint32_t)n << k) < a && k < ESCAPE_BITS)
+      k++;
+    return k;
+  }
+
+  void add(uint16_t u) {
+    a += u;
+    if (++n == 16) {
+      a >>= 1;
+      n >>= 1;
+    }
+  }
+};
+
+// median predictor from the left, upper and upper left neighbours
+static int16_t predictSpatial(const int16_t *v, uint8_t i) {
+  uint8_t x = i & 0x07;
+  if (i < AMG88xx_PIXEL_COLS)
+    return x ? v[i - 1] : 0;
+  if (!x)
+    return v[i - AMG88xx_PIXEL_COLS];
+
+  int16_t a = v[i - 1];
+  int16_t b = v[i - AMG88xx_PIXEL_COLS];
+  int16_t c = v[i - AMG88xx_PIXEL_COLS - 1];
+  if (c >= max(a, b))
+    return min(a, b);
+  if (c <= min(a, b))
+    return max(a, b);
+  return a + b - c;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Create an encoder
+    @param  keyInterval a keyframe is sent at least every this many frames,
+   and 0 makes every frame a keyframe
+*/
+/**************************************************************************/
+AMG88xx_FrameEncoder::AMG88xx_FrameEncoder(uint8_t keyInterval)
+    : _keyInterval(keyInterval) {
+  memset(_prev, 0, sizeof(_prev));
+  reset();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Make the next frame a keyframe
+*/
+/**************************************************************************/
+void AMG88xx_FrameEncoder::reset() { _sinceKey = _keyInterval; }
+
+/**************************************************************************/
+/*!
+    @brief  Compress one frame. The thermistor is not included.
+    @param  frame the frame
+    @param  out where to place the encoded frame, AMG88xx_CODEC_MAX_SIZE
+   bytes
+    @returns the encoded size in bytes
+*/
+/**************************************************************************/
+uint8_t AMG88xx_FrameEncoder::encode(const AMG88xx_RawFrame &frame,
+                                     uint8_t *out) {
+  int16_t v[AMG88xx_PIXEL_ARRAY_SIZE];
+  uint32_t spatialCost = 0, temporalCost = 0;
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++)
+    v[i] = frame.pixel(i);
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++) {
+    spatialCost += abs(v[i] - predictSpatial(v, i));
+    temporalCost += abs(v[i] - _prev[i]);
+  }
+
+  bool key = _sinceKey >= _keyInterval;
+  uint8_t flags = key ? AMG88xx_CODEC_KEY : 0;
+  if (!key && temporalCost < spatialCost)
+    flags |= AMG88xx_CODEC_TEMPORAL;
+  _sinceKey = key ? 1 : _sinceKey + 1;
+
+  out[0] = flags;
+  out[1] = ++_count;
+  uint8_t *p = out + 2;
+  uint8_t acc = 0, used = 0; // bits waiting in acc
+
+  RiceState state;
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++) {
+    int16_t pred =
+        (flags & AMG88xx_CODEC_TEMPORAL) ? _prev[i] : predictSpatial(v, i);
+    int16_t r = v[i] - pred;
+    uint16_t u = r < 0 ? ((uint16_t)-r << 1) - 1 : (uint16_t)r << 1;
+    uint8_t k = state.k();
+    state.add(u);
+
+    // code as q ones, a zero and k low bits, or ESCAPE ones and 13 bits
+    uint16_t q = u >> k;
+    uint32_t bits;
+    uint8_t n;
+    if (q < ESCAPE) {
+      bits = ((((uint32_t)1 << q) - 1) << (k + 1)) | (u & ((1 << k) - 1));
+      n = q + 1 + k;
+    } else {
+      bits = ((((uint32_t)1 << ESCAPE) - 1) << ESCAPE_BITS) | u;
+      n = ESCAPE + ESCAPE_BITS;
+    }
+
+    while (n) {
+      uint8_t take = min((uint8_t)(8 - used), n);
+      n -= take;
+      acc = (acc << take) | ((bits >> n) & ((1 << take) - 1));
+      used += take;
+      if (used == 8) {
+        *p++ = acc;
+        acc = 0;
+        used = 0;
+      }
+    }
+  }
+  if (used)
+    *p++ = acc << (8 - used);
+
+  memcpy(_prev, v, sizeof(_prev));
+  return p - out;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Decompress one frame. The thermistor of frame is left alone.
+    @param  in the encoded frame
+    @param  len its size in bytes
+    @param  frame where to place the pixels
+    @returns True if the frame decoded, false if it is damaged or refers to
+   a frame that was not received
+*/
+/**************************************************************************/
+bool AMG88xx_FrameDecoder::decode(const uint8_t *in, uint8_t len,
+                                  AMG88xx_RawFrame *frame) {
+  if (len < 2)
+    return false;
+  uint8_t flags = in[0];
+  uint8_t count = in[1];
+
+  if (!(flags & AMG88xx_CODEC_KEY) &&
+      (!_valid || count != (uint8_t)(_count + 1))) {
+    _valid = false;
+    return false;
+  }
+
+  const uint8_t *p = in + 2;
+  const uint8_t *end = in + len;
+  uint8_t bit = 0; // next bit of *p, from the top
+
+  int16_t v[AMG88xx_PIXEL_ARRAY_SIZE];
+  RiceState state;
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++) {
+    uint8_t k = state.k();
+
+    uint8_t q = 0;
+    for (;;) {
+      if (p == end)
+        return false;
+      bool one = (*p << bit) & 0x80;
+      if (++bit == 8) {
+        bit = 0;
+        p++;
+      }
+      if (!one)
+        break;
+      if (++q == ESCAPE)
+        break;
+    }
+
+    uint8_t n = q == ESCAPE ? ESCAPE_BITS : k;
+    uint16_t low = 0;
+    while (n--) {
+      if (p == end)
+        return false;
+      low = (low << 1) | ((*p >> (7 - bit)) & 1);
+      if (++bit == 8) {
+        bit = 0;
+        p++;
+      }
+    }
+    uint16_t u = q == ESCAPE ? low : ((uint16_t)q << k) | low;
+    state.add(u);
+
+    int16_t r = (u & 1) ? -(int16_t)((u + 1) >> 1) : (int16_t)(u >> 1);
+    int16_t pred =
+        (flags & AMG88xx_CODEC_TEMPORAL) ? _prev[i] : predictSpatial(v, i);
+    v[i] = pred + r;
+    if (v[i] < -2048 || v[i] > 2047)
+      return false;
+  }
+
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++) {
+    frame->pixels[i << 1] = v[i] & 0xFF;
+    frame->pixels[(i << 1) + 1] = (v[i] >> 8) & 0x0F;
+  }
+  memcpy(_prev, v, sizeof(_prev));
+  _count = count;
+  _valid = true;
+  return true;
+}
@@ -0,0 +1,177 @@
+#if !defined(ARDUINO)
+
+#include "Adafruit_AMG88xx_Host.h"
+
+#include <time.h>
+
+TwoWire Wire;
+
+static bool virtualClock = false;
+static uint32_t virtualNow = 0;
+
+/**************************************************************************/
+/*!
+    @brief  Milliseconds since an arbitrary start, from the monotonic clock
+   or the virtual clock
+    @returns the time in milliseconds
+*/
+/**************************************************************************/
+uint32_t millis() {
+  if (virtualClock)
+    return virtualNow;
+
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Microseconds since an arbitrary start, from the monotonic clock
+   or the virtual clock
+    @returns the time in microseconds
+*/
+/**************************************************************************/
+uint32_t micros() {
+  if (virtualClock)
+    return virtualNow * 1000;
+
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Wait, or with the virtual clock just move time forward
+    @param  ms the time to wait in milliseconds
+*/
+/**************************************************************************/
+void delay(uint32_t ms) {
+  if (virtualClock) {
+    virtualNow += ms;
+    return;
+  }
+
+  struct timespec ts;
+  ts.tv_sec = ms / 1000;
+  ts.tv_nsec = (long)(ms % 1000) * 1000000;
+  nanosleep(&ts, NULL);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Switch between wall clock time and a virtual clock that only
+   moves on delay(). The virtual clock lets tests and benchmarks run
+   simulated frames as fast as the host allows.
+    @param  enable True for the virtual clock
+*/
+/**************************************************************************/
+void AMG88xx_useVirtualClock(bool enable) { virtualClock = enable; }
+
+/**************************************************************************/
+/*!
+    @brief  Put a simulated sensor on the bus
+    @param  sim the sensor, answering on sim->address()
+    @returns True if there was room on the bus and the address was free
+*/
+/**************************************************************************/
+bool TwoWire::attach(AMG88xx_Simulator *sim) {
+  if (device(sim->address()))
+    return false;
+  for (uint8_t i = 0; i < AMG88xx_HOST_MAX_DEVICES; i++) {
+    if (!_devices[i]) {
+      _devices[i] = sim;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Remove every simulated sensor from the bus
+*/
+/**************************************************************************/
+void TwoWire::detachAll() { memset(_devices, 0, sizeof(_devices)); }
+
+/**************************************************************************/
+/*!
+    @brief  Find the simulated sensor at an address
+    @param  addr the I2C address
+    @returns the sensor, or NULL if nothing answers there
+*/
+/**************************************************************************/
+AMG88xx_Simulator *TwoWire::device(uint8_t addr) {
+  for (uint8_t i = 0; i < AMG88xx_HOST_MAX_DEVICES; i++) {
+    if (_devices[i] && _devices[i]->address() == addr)
+      return _devices[i];
+  }
+  return NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Create a device on a simulated bus
+    @param  addr the I2C address
+    @param  theWire the simulated bus, defaults to &Wire
+*/
+/**************************************************************************/
+Adafruit_I2CDevice::Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire)
+    : _addr(addr), _wire(theWire) {}
+
+/**************************************************************************/
+/*!
+    @brief  Check that a simulated sensor answers at the address
+    @param  addr_detect unused, the address is always checked
+    @returns True if a sensor is attached at the address
+*/
+/**************************************************************************/
+bool Adafruit_I2CDevice::begin(bool addr_detect) {
+  (void)addr_detect;
+  return sim() != NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Read from the simulated sensor
+    @param  buffer where to place the bytes
+    @param  len number of bytes to read
+    @param  stop unused
+    @returns True if a sensor answered
+*/
+/**************************************************************************/
+bool Adafruit_I2CDevice::read(uint8_t *buffer, size_t len, bool stop) {
+  (void)stop;
+  AMG88xx_Simulator *s = sim();
+  return s && s->read(buffer, len);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Write to the simulated sensor
+    @param  buffer the bytes to write after the prefix
+    @param  len number of bytes in buffer
+    @param  stop unused
+    @param  prefix_buffer optional bytes sent first
+    @param  prefix_len number of bytes in prefix_buffer
+    @returns True if a sensor answered
+*/
+/**************************************************************************/
+bool Adafruit_I2CDevice::write(const uint8_t *buffer, size_t len, bool stop,
+                               const uint8_t *prefix_buffer,
+                               size_t prefix_len) {
+  (void)stop;
+  AMG88xx_Simulator *s = sim();
+  return s && s->write(buffer, len, prefix_buffer, prefix_len);
+}
+
+// the sensor at our address with its clock brought up to date
+AMG88xx_Simulator *Adafruit_I2CDevice::sim() {
+  AMG88xx_Simulator *s = _wire->device(_addr);
+  if (s)
+    s->update(millis());
+  return s;
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_HOST_H
+#define LIB_ADAFRUIT_AMG88XX_HOST_H
+
+/*=========================================================================
+    HOST BUILDS
+    -----------------------------------------------------------------------
+    Outside of Arduino the driver runs against AMG88xx_Simulator. This
+    header stands in for the parts of Arduino.h and Adafruit BusIO the
+    driver uses: TwoWire becomes a bus of simulated sensors and
+    Adafruit_I2CDevice forwards to the one at its address.
+    -----------------------------------------------------------------------*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Adafruit_AMG88xx_Simulator.h"
+
+typedef uint8_t byte;
+
+/*! @brief smaller of two values @param a first @param b second @returns min */
+template <class T> static inline T min(T a, T b) { return b < a ? b : a; }
+/*! @brief larger of two values @param a first @param b second @returns max */
+template <class T> static inline T max(T a, T b) { return a < b ? b : a; }
+/*!
+    @brief  clamp a value to a range
+    @param  v the value
+    @param  lo the lower bound
+    @param  hi the upper bound
+    @returns the clamped value
+*/
+template <class T> static inline T constrain(T v, T lo, T hi) {
+  return v < lo ? lo : (hi < v ? hi : v);
+}
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void AMG88xx_useVirtualClock(bool enable);
+
+/**************************************************************************/
+/*!
+    @brief  The byte sink half of Arduino's Print, so code writing to a
+   Print builds on the host too
+*/
+/**************************************************************************/
+class Print {
+public:
+  virtual ~Print() {}
+
+  /*! @brief write one byte @param b the byte @returns bytes written */
+  virtual size_t write(uint8_t b) = 0;
+
+  /*!
+      @brief  write a block of bytes
+      @param  buffer the bytes
+      @param  size number of bytes
+      @returns bytes written
+  */
+  virtual size_t write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while (size-- && write(*buffer++))
+      n++;
+    return n;
+  }
+};
+
+#ifndef AMG88xx_HOST_MAX_DEVICES
+#define AMG88xx_HOST_MAX_DEVICES 8
+#endif
+
+/**************************************************************************/
+/*!
+    @brief  A simulated I2C bus holding simulated sensors
+*/
+/**************************************************************************/
+class TwoWire {
+public:
+  TwoWire(void) { memset(_devices, 0, sizeof(_devices)); }
+
+  bool attach(AMG88xx_Simulator *sim);
+  void detachAll();
+  AMG88xx_Simulator *device(uint8_t addr);
+
+private:
+  AMG88xx_Simulator *_devices[AMG88xx_HOST_MAX_DEVICES];
+};
+
+extern TwoWire Wire;
+
+/**************************************************************************/
+/*!
+    @brief  The subset of the BusIO I2C device the driver uses, routed to a
+   simulated sensor. Every transaction first runs the sensor's frame clock
+   up to millis().
+*/
+/**************************************************************************/
+class Adafruit_I2CDevice {
+public:
+  Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire = &Wire);
+
+  bool begin(bool addr_detect = true);
+  bool read(uint8_t *buffer, size_t len, bool stop = true);
+  bool write(const uint8_t *buffer, size_t len, bool stop = true,
+             const uint8_t *prefix_buffer = NULL, size_t prefix_len = 0);
+
+  /*! @brief largest transfer, matching the AVR Wire buffer @returns size */
+  size_t maxBufferSize() { return 32; }
+
+private:
+  AMG88xx_Simulator *sim();
+
+  uint8_t _addr;
+  TwoWire *_wire;
+};
+
+#endif
@@ -0,0 +1,617 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_IMPL_H
+#define LIB_ADAFRUIT_AMG88XX_IMPL_H
+
+// Member definitions of Adafruit_AMG88xx_Driver. The driver is a template
+// over its bus policy, so these live in a header; include
+// Adafruit_AMG88xx.h rather than this file.
+
+/**************************************************************************/
+/*!
+    @brief  Setups the bus and hardware
+    @param  args the bus policy's begin() arguments. For Adafruit_AMG88xx
+   these are the optional I2C address (default 0x69) and the I2C object to
+   use (default &Wire)
+    @returns True if device is set up, false on any failure
+*/
+/**************************************************************************/
+template <class Bus>
+template <typename... Args>
+bool Adafruit_AMG88xx_Driver<Bus>::begin(Args... args) {
+  if (!_bus.begin(args...) || !resetDevice())
+    return false;
+
+  // disable interrupts by default
+  disableInterrupt();
+
+  // set to 10 FPS
+  _fpsc.FPS = AMG88xx_FPS_10;
+  write8(AMG88xx_FPSC, _fpsc.get());
+
+  _bus.delay(100);
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set up several sensors at once. All sensors are reset back to
+   back and configured with the same profile, then share a single settle
+   delay instead of paying one per sensor.
+    @param  sensors the sensors to set up
+    @param  args the first bus begin() argument of each sensor, for
+   Adafruit_AMG88xx the I2C addresses
+    @param  count the number of sensors (up to 32)
+    @param  profile the configuration to apply to every sensor
+    @param  rest further bus begin() arguments shared by all sensors, for
+   Adafruit_AMG88xx the I2C object, defaults to &Wire
+    @returns a bitmask with bit n set if sensors[n] was set up with the
+   profile
+*/
+/**************************************************************************/
+template <class Bus>
+template <typename Arg, typename... Rest>
+uint32_t Adafruit_AMG88xx_Driver<Bus>::beginAll(
+    Adafruit_AMG88xx_Driver *const *sensors, const Arg *args, uint8_t count,
+    const AMG88xx_Profile &profile, Rest... rest) {
+  uint32_t started = 0;
+  Adafruit_AMG88xx_Driver *first = NULL;
+  count = min(count, (uint8_t)32);
+
+  for (uint8_t i = 0; i < count; i++) {
+    if (!sensors[i]->_bus.begin(args[i], rest...) ||
+        !sensors[i]->resetDevice() || !sensors[i]->apply(profile))
+      continue;
+    started |= (uint32_t)1 << i;
+    if (!first)
+      first = sensors[i];
+  }
+
+  if (first)
+    first->_bus.delay(100);
+
+  return started;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Bring the sensor to a configuration profile with as few writes
+   as possible. Only registers that differ from what the sensor is known to
+   hold are written, each group of adjacent registers as one burst, so
+   applying an unchanged profile costs nothing and changing one setting
+   costs one transaction. After begin() every register is written once.
+    @param  profile the configuration to write
+    @param  verify read the registers back in one burst and compare them
+    @returns True if every write succeeded and, when verifying, the sensor
+   holds the profile
+*/
+/**************************************************************************/
+template <class Bus>
+bool Adafruit_AMG88xx_Driver<Bus>::apply(const AMG88xx_Profile &profile,
+                                         bool verify) {
+  uint8_t want[AMG88xx_TTHL];
+
+  _pctl.PCTL = profile.powerMode;
+  _fpsc.FPS = profile.frameRate;
+  _intc.INTEN = profile.interruptEnable;
+  _intc.INTMOD = profile.interruptMode;
+  _ave.MAMOD = profile.movingAverage;
+  uint16_t high = levelToRaw(profile.interruptHigh);
+  uint16_t low = levelToRaw(profile.interruptLow);
+  uint16_t hys = levelToRaw(profile.interruptHysteresis);
+  _inthl.INT_LVL_H = high & 0xFF;
+  _inthh.INT_LVL_H = high >> 8;
+  _intll.INT_LVL_L = low & 0xFF;
+  _intlh.INT_LVL_L = low >> 8;
+  _ihysl.INT_HYS = hys & 0xFF;
+  _ihysh.INT_HYS = hys >> 8;
+
+  want[AMG88xx_PCTL] = _pctl.get();
+  want[AMG88xx_FPSC] = _fpsc.get();
+  want[AMG88xx_INTC] = _intc.get();
+  want[AMG88xx_AVE] = _ave.get();
+  want[AMG88xx_INTHL] = _inthl.get();
+  want[AMG88xx_INTHH] = _inthh.get();
+  want[AMG88xx_INTLL] = _intll.get();
+  want[AMG88xx_INTLH] = _intlh.get();
+  want[AMG88xx_IHYSL] = _ihysl.get();
+  want[AMG88xx_IHYSH] = _ihysh.get();
+
+  // wake before configuring, and only go to sleep once configured
+  bool sleep = profile.powerMode == AMG88xx_SLEEP_MODE;
+  bool ok = true;
+  if (!sleep) {
+    bool waking = (_known & (1 << AMG88xx_PCTL)) &&
+                  _regs[AMG88xx_PCTL] == AMG88xx_SLEEP_MODE;
+    ok = update(want, AMG88xx_PCTL, AMG88xx_PCTL);
+    if (ok && waking)
+      _bus.delay(50);
+  }
+  // FPSC and INTC are adjacent, as are AVE and the interrupt levels
+  ok = update(want, AMG88xx_FPSC, AMG88xx_INTC) && ok;
+  ok = update(want, AMG88xx_AVE, AMG88xx_IHYSH) && ok;
+  if (sleep)
+    ok = update(want, AMG88xx_PCTL, AMG88xx_PCTL) && ok;
+
+  if (!verify)
+    return ok;
+
+  AMG88xx_RegisterSnapshot snapshot;
+  if (!readRegisterSnapshot(&snapshot))
+    return false;
+  for (uint8_t r = 0; r < AMG88xx_TTHL; r++) {
+    if ((AMG88xx_CONFIG_REGS & (1 << r)) &&
+        (snapshot.regs[r] & configMask(r)) != want[r])
+      ok = false;
+  }
+  return ok;
+}
+
+// the bits a configuration register implements
+template <class Bus>
+uint8_t Adafruit_AMG88xx_Driver<Bus>::configMask(uint8_t reg) {
+  switch (reg) {
+  case AMG88xx_FPSC:
+    return 0x01;
+  case AMG88xx_INTC:
+    return 0x03;
+  case AMG88xx_AVE:
+    return 0x20;
+  case AMG88xx_INTHH:
+  case AMG88xx_INTLH:
+  case AMG88xx_IHYSH:
+    return 0x0F;
+  default:
+    return 0xFF;
+  }
+}
+
+// write the registers first to last as one burst, trimmed to the span that
+// differs from what the sensor is known to hold
+template <class Bus>
+bool Adafruit_AMG88xx_Driver<Bus>::update(const uint8_t *want, uint8_t first,
+                                          uint8_t last) {
+  while (first <= last && (_known & (1 << first)) &&
+         _regs[first] == want[first])
+    first++;
+  while (last > first && (_known & (1 << last)) && _regs[last] == want[last])
+    last--;
+  if (first > last)
+    return true;
+  return this->write(first, want + first, last - first + 1);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Put the sensor in normal mode and issue an initial reset
+    @returns True if the sensor acknowledged, false otherwise
+*/
+/**************************************************************************/
+template <class Bus> bool Adafruit_AMG88xx_Driver<Bus>::resetDevice() {
+  // enter normal mode and software reset. PCTL and RST are adjacent so both
+  // go out in one transaction
+  _pctl.PCTL = AMG88xx_NORMAL_MODE;
+  _rst.RST = AMG88xx_INITIAL_RESET;
+  _known = 0; // every setting returns to its default
+  uint8_t buf[2] = {_pctl.get(), _rst.get()};
+  return this->write(AMG88xx_PCTL, buf, 2);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set the moving average mode.
+    @param  mode if True is passed, output will be twice the moving average
+*/
+/**************************************************************************/
+template <class Bus>
+void Adafruit_AMG88xx_Driver<Bus>::setMovingAverageMode(bool mode) {
+  _ave.MAMOD = mode;
+  write8(AMG88xx_AVE, _ave.get());
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set the interrupt levels. The hysteresis value defaults to .95 *
+   high
+    @param  high the value above which an interrupt will be triggered
+    @param  low the value below which an interrupt will be triggered
+*/
+/**************************************************************************/
+template <class Bus>
+void Adafruit_AMG88xx_Driver<Bus>::setInterruptLevels(float high,
+                                                      float low) {
+  setInterruptLevels(high, low, high * .95);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set the interrupt levels
+    @param  high the value above which an interrupt will be triggered
+    @param  low the value below which an interrupt will be triggered
+    @param hysteresis the hysteresis value for interrupt detection
+*/
+/**************************************************************************/
+template <class Bus>
+void Adafruit_AMG88xx_Driver<Bus>::setInterruptLevels(float high, float low,
+                                                      float hysteresis) {
+  uint16_t highConv = levelToRaw(high);
+  _inthl.INT_LVL_H = highConv & 0xFF;
+  _inthh.INT_LVL_H = highConv >> 8;
+
+  uint16_t lowConv = levelToRaw(low);
+  _intll.INT_LVL_L = lowConv & 0xFF;
+  _intlh.INT_LVL_L = lowConv >> 8;
+
+  uint16_t hysConv = levelToRaw(hysteresis);
+  _ihysl.INT_HYS = hysConv & 0xFF;
+  _ihysh.INT_HYS = hysConv >> 8;
+
+  // INTHL through IHYSH are contiguous, write them in one go
+  uint8_t buf[6] = {_inthl.get(), _inthh.get(), _intll.get(),
+                    _intlh.get(), _ihysl.get(), _ihysh.get()};
+  this->write(AMG88xx_INTHL, buf, 6);
+}
+
+/**************************************************************************/
+/*!
+    @brief  convert a temperature level to the 12-bit two's complement
+   register format
+    @param  level the temperature in degrees Celsius
+    @returns the 12-bit register value
+*/
+/**************************************************************************/
+template <class Bus>
+uint16_t Adafruit_AMG88xx_Driver<Bus>::levelToRaw(float level) {
+  int conv = level / AMG88xx_PIXEL_TEMP_CONVERSION;
+  conv = constrain(conv, -2048, 2047);
+  return conv & 0xFFF;
+}
+
+/**************************************************************************/
+/*!
+    @brief  enable the interrupt pin on the device.
+*/
+/**************************************************************************/
+template <class Bus>
+void Adafruit_AMG88xx_Driver<Bus>::enableInterrupt() {
+  _intc.INTEN = 1;
+  this->write8(AMG88xx_INTC, _intc.get());
+}
+
+/**************************************************************************/
+/*!
+    @brief  disable the interrupt pin on the device
+*/
+/**************************************************************************/
+template <class Bus>
+void Adafruit_AMG88xx_Driver<Bus>::disableInterrupt() {
+  _intc.INTEN = 0;
+  this->write8(AMG88xx_INTC, _intc.get());
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set the interrupt to either absolute value or difference mode
+    @param  mode passing AMG88xx_DIFFERENCE sets the device to difference mode,
+   AMG88xx_ABSOLUTE_VALUE sets to absolute value mode.
+*/
+/**************************************************************************/
+template <class Bus>
+void Adafruit_AMG88xx_Driver<Bus>::setInterruptMode(uint8_t mode) {
+  _intc.INTMOD = mode;
+  this->write8(AMG88xx_INTC, _intc.get());
+}
+
+/**************************************************************************/
+/*!
+    @brief  Read the state of the triggered interrupts on the device. The full
+   interrupt register is 8 bytes in length.
+    @param  buf the pointer to where the returned data will be stored
+    @param  size Optional number of bytes to read. Default is 8 bytes.
+    @returns up to 8 bytes of data in buf
+*/
+/**************************************************************************/
+template <class Bus>
+void Adafruit_AMG88xx_Driver<Bus>::getInterrupt(uint8_t *buf,
+                                                uint8_t size) {
+  uint8_t bytesToRead = min(size, (uint8_t)8);
+
+  this->read(AMG88xx_INT_OFFSET, buf, bytesToRead);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clear any triggered interrupts
+*/
+/**************************************************************************/
+template <class Bus>
+void Adafruit_AMG88xx_Driver<Bus>::clearInterrupt() {
+  _rst.RST = AMG88xx_FLAG_RESET;
+  write8(AMG88xx_RST, _rst.get());
+}
+
+/**************************************************************************/
+/*!
+    @brief  read the onboard thermistor
+    @returns a the floating point temperature in degrees Celsius
+*/
+/**************************************************************************/
+template <class Bus>
+float Adafruit_AMG88xx_Driver<Bus>::readThermistor() {
+  uint8_t raw[2];
+  this->read(AMG88xx_TTHL, raw, 2);
+  uint16_t recast = ((uint16_t)raw[1] << 8) | ((uint16_t)raw[0]);
+
+  return signedMag12ToFloat(recast) * AMG88xx_THERMISTOR_CONVERSION;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Read Infrared sensor values
+    @param  buf the array to place the pixels in
+    @param  size Optionsl number of bytes to read (up to 64). Default is 64
+   bytes.
+    @param  stats Optional summary to fill in while decoding
+    @return up to 64 bytes of pixel data in buf
+*/
+/**************************************************************************/
+template <class Bus>
+void Adafruit_AMG88xx_Driver<Bus>::readPixels(float *buf, uint8_t size,
+                                              AMG88xx_FrameStats *stats) {
+  size = min(size, (uint8_t)AMG88xx_PIXEL_ARRAY_SIZE);
+  uint8_t rawArray[AMG88xx_PIXEL_ARRAY_SIZE << 1];
+  AMG88xx_PROFILE_START(AMG88xx_STAGE_BUS);
+  this->read(AMG88xx_PIXEL_OFFSET, rawArray, size << 1);
+  AMG88xx_PROFILE_STOP(AMG88xx_STAGE_BUS);
+
+  AMG88xx_PROFILE_START(AMG88xx_STAGE_DECODE);
+  if (stats)
+    stats->reset();
+
+  for (int i = 0; i < size; i++) {
+    int16_t val = decodePixel(rawArray, i);
+    buf[i] = val * AMG88xx_PIXEL_TEMP_CONVERSION;
+    if (stats)
+      stats->add(i, val);
+  }
+  AMG88xx_PROFILE_STOP(AMG88xx_STAGE_DECODE);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Read Infrared sensor values without converting them to floating
+   point. Each value is a signed count of AMG88xx_PIXEL_TEMP_CONVERSION
+   degrees Celsius.
+    @param  buf the array to place the pixels in
+    @param  size Optional number of pixels to read (up to 64). Default is 64
+   pixels.
+    @param  stats Optional summary to fill in while decoding
+*/
+/**************************************************************************/
+template <class Bus>
+void Adafruit_AMG88xx_Driver<Bus>::readPixelsRaw(int16_t *buf, uint8_t size,
+                                                 AMG88xx_FrameStats *stats) {
+  size = min(size, (uint8_t)AMG88xx_PIXEL_ARRAY_SIZE);
+  uint8_t rawArray[AMG88xx_PIXEL_ARRAY_SIZE << 1];
+  AMG88xx_PROFILE_START(AMG88xx_STAGE_BUS);
+  this->read(AMG88xx_PIXEL_OFFSET, rawArray, size << 1);
+  AMG88xx_PROFILE_STOP(AMG88xx_STAGE_BUS);
+
+  AMG88xx_PROFILE_START(AMG88xx_STAGE_DECODE);
+  if (stats)
+    stats->reset();
+
+  for (int i = 0; i < size; i++) {
+    buf[i] = decodePixel(rawArray, i);
+    if (stats)
+      stats->add(i, buf[i]);
+  }
+  AMG88xx_PROFILE_STOP(AMG88xx_STAGE_DECODE);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Read a frame and summarize it without keeping the pixels
+    @param  stats the summary to fill in
+*/
+/**************************************************************************/
+template <class Bus>
+void Adafruit_AMG88xx_Driver<Bus>::readStats(AMG88xx_FrameStats *stats) {
+  uint8_t rawArray[AMG88xx_PIXEL_ARRAY_SIZE << 1];
+  AMG88xx_PROFILE_START(AMG88xx_STAGE_BUS);
+  this->read(AMG88xx_PIXEL_OFFSET, rawArray, sizeof(rawArray));
+  AMG88xx_PROFILE_STOP(AMG88xx_STAGE_BUS);
+
+  AMG88xx_PROFILE_START(AMG88xx_STAGE_DECODE);
+  stats->reset();
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++) {
+    stats->add(i, decodePixel(rawArray, i));
+  }
+  AMG88xx_PROFILE_STOP(AMG88xx_STAGE_DECODE);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Read the thermistor and pixel registers as they are, leaving
+   decoding to whoever ends up with the frame. Calibration is not applied.
+    @param  frame the frame to fill in
+    @returns True if both reads succeeded
+*/
+/**************************************************************************/
+template <class Bus>
+bool Adafruit_AMG88xx_Driver<Bus>::readRawFrame(AMG88xx_RawFrame *frame) {
+  AMG88xx_PROFILE_START(AMG88xx_STAGE_BUS);
+  bool ok =
+      this->read(AMG88xx_TTHL, frame->thermistor, sizeof(frame->thermistor)) &&
+      this->read(AMG88xx_PIXEL_OFFSET, frame->pixels, sizeof(frame->pixels));
+  AMG88xx_PROFILE_STOP(AMG88xx_STAGE_BUS);
+  return ok;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Read every control and status register, 0x00 to 0x0F, in one
+   transaction. Power mode, frame rate, status flags, interrupt setup and
+   the thermistor all come from the one read, for cheap health checks.
+    @param  snapshot where to place the registers
+    @returns True if the read succeeded
+*/
+/**************************************************************************/
+template <class Bus>
+bool Adafruit_AMG88xx_Driver<Bus>::readRegisterSnapshot(
+    AMG88xx_RegisterSnapshot *snapshot) {
+  if (!this->read(AMG88xx_PCTL, snapshot->regs, sizeof(snapshot->regs)))
+    return false;
+  for (uint8_t r = 0; r < AMG88xx_TTHL; r++)
+    _regs[r] = snapshot->regs[r] & configMask(r);
+  _known = AMG88xx_CONFIG_REGS;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Correct every pixel read from now on with a per-pixel offset and
+   gain. The correction is applied while the raw bytes are decoded, so it
+   adds no extra pass over the frame.
+    @param  cal the correction tables, or NULL to turn correction off. The
+   tables are not copied and must stay valid while in use.
+*/
+/**************************************************************************/
+template <class Bus>
+void Adafruit_AMG88xx_Driver<Bus>::setCalibration(
+    const AMG88xx_Calibration *cal) {
+  _cal = cal;
+}
+
+/**************************************************************************/
+/*!
+    @brief  write one byte of data to the specified register
+    @param  reg the register to write to
+    @param  value the value to write
+*/
+/**************************************************************************/
+template <class Bus>
+void Adafruit_AMG88xx_Driver<Bus>::write8(byte reg, byte value) {
+  this->write(reg, &value, 1);
+}
+
+/**************************************************************************/
+/*!
+    @brief  read one byte of data from the specified register
+    @param  reg the register to read
+    @returns one byte of register data
+*/
+/**************************************************************************/
+template <class Bus>
+uint8_t Adafruit_AMG88xx_Driver<Bus>::read8(byte reg) {
+  uint8_t ret;
+  this->read(reg, &ret, 1);
+
+  return ret;
+}
+
+/**************************************************************************/
+/*!
+    @brief  read consecutive registers through the bus, retrying failed
+   transfers and counting them if enabled
+    @param  reg the first register
+    @param  buf where to place the data
+    @param  num the number of bytes to read
+    @returns True on success
+*/
+/**************************************************************************/
+template <class Bus>
+bool Adafruit_AMG88xx_Driver<Bus>::read(uint8_t reg, uint8_t *buf,
+                                        uint8_t num) {
+  for (uint8_t attempt = 0;; attempt++) {
+#if defined(AMG88xx_BUS_STATS)
+    uint32_t start = micros();
+#endif
+    bool ok = _bus.read(reg, buf, num);
+#if defined(AMG88xx_BUS_STATS)
+    uint8_t size = _bus.maxTransfer();
+    _busStats.read.add(num, (num + size - 1) / size, ok, attempt,
+                       micros() - start);
+#endif
+    if (ok || attempt == AMG88xx_BUS_RETRIES)
+      return ok;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  write consecutive registers through the bus, retrying failed
+   transfers and counting them if enabled
+    @param  reg the first register
+    @param  buf the data to write
+    @param  num the number of bytes to write
+    @returns True on success
+*/
+/**************************************************************************/
+template <class Bus>
+bool Adafruit_AMG88xx_Driver<Bus>::write(uint8_t reg, const uint8_t *buf,
+                                         uint8_t num) {
+  for (uint8_t attempt = 0;; attempt++) {
+#if defined(AMG88xx_BUS_STATS)
+    uint32_t start = micros();
+#endif
+    bool ok = _bus.write(reg, buf, num);
+#if defined(AMG88xx_BUS_STATS)
+    _busStats.write.add(num, 1, ok, attempt, micros() - start);
+#endif
+    if (ok || attempt == AMG88xx_BUS_RETRIES) {
+      // remember the settings written; after a failure they are unknown
+      for (uint8_t i = 0; i < num && reg + i < AMG88xx_TTHL; i++) {
+        uint16_t bit = (uint16_t)1 << (reg + i);
+        if (!(AMG88xx_CONFIG_REGS & bit))
+          continue;
+        _regs[reg + i] = buf[i];
+        _known = ok ? _known | bit : _known & ~bit;
+      }
+      return ok;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  convert a 12-bit signed magnitude value to a floating point number
+    @param  val the 12-bit signed magnitude value to be converted
+    @returns the converted floating point value
+*/
+/**************************************************************************/
+template <class Bus>
+float Adafruit_AMG88xx_Driver<Bus>::signedMag12ToFloat(uint16_t val) {
+  // take first 11 bits as absolute val
+  uint16_t absVal = (val & 0x7FF);
+
+  return (val & 0x800) ? 0 - (float)absVal : (float)absVal;
+}
+
+/**************************************************************************/
+/*!
+    @brief  decode one pixel from the raw register bytes, applying the
+   calibration tables if set
+    @param  raw the pixel register bytes, two per pixel, low byte first
+    @param  i the index of the pixel to decode
+    @returns the pixel value in counts of AMG88xx_PIXEL_TEMP_CONVERSION
+*/
+/**************************************************************************/
+template <class Bus>
+int16_t Adafruit_AMG88xx_Driver<Bus>::decodePixel(const uint8_t *raw,
+                                                  uint8_t i) {
+  uint8_t pos = i << 1;
+  uint16_t recast = ((uint16_t)raw[pos + 1] << 8) | ((uint16_t)raw[pos]);
+
+  // shift to left so that sign bit of 12 bit integer number is placed on
+  // sign bit of 16 bit signed integer number, then shift back
+  int16_t val = (int16_t)(recast << 4) >> 4;
+
+  if (_cal) {
+    int32_t corrected = (int32_t)(val - _cal->offset[i]) * _cal->gain[i];
+    val = (corrected + (AMG88xx_CAL_GAIN_ONE >> 1)) >> AMG88xx_CAL_GAIN_SHIFT;
+  }
+
+  return val;
+}
+
+#endif
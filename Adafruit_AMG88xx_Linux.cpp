@@ -0,0 +1,204 @@
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "Adafruit_AMG88xx_Linux.h"
+
+#include <fcntl.h>
+#include <linux/i2c-dev.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+// monotonic time in nanoseconds
+static uint64_t nanos() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Open an I2C adapter device node
+    @param  path the device node, for example "/dev/i2c-1"
+    @returns True if the node was opened and supports plain I2C transfers
+*/
+/**************************************************************************/
+bool AMG88xx_LinuxI2CAdapter::open(const char *path) {
+  close();
+
+  _fd = ::open(path, O_RDWR | O_CLOEXEC);
+  if (_fd < 0)
+    return false;
+
+  unsigned long funcs = 0;
+  if (ioctl(_fd, I2C_FUNCS, &funcs) < 0 || !(funcs & I2C_FUNC_I2C)) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Run the adapter on a transfer function instead of a device node
+    @param  transfer called for every transaction
+    @param  context passed to transfer, for AMG88xx_simulatorTransfer the
+   TwoWire holding the simulated sensors
+    @returns True if transfer is not NULL
+*/
+/**************************************************************************/
+bool AMG88xx_LinuxI2CAdapter::open(AMG88xx_I2CTransfer transfer,
+                                   void *context) {
+  close();
+  _transfer = transfer;
+  _context = context;
+  return _transfer != NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Close the device node or let go of the transfer function
+*/
+/**************************************************************************/
+void AMG88xx_LinuxI2CAdapter::close() {
+  if (_fd >= 0)
+    ::close(_fd);
+  _fd = -1;
+  _transfer = NULL;
+  _context = NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Carry out one combined transaction in a single kernel call
+    @param  msgs the messages, each with its own device address
+    @param  count number of messages (up to I2C_RDWR_IOCTL_MAX_MSGS)
+    @param  latency where to place the time the call took in nanoseconds
+    @returns True if every message was acknowledged
+*/
+/**************************************************************************/
+bool AMG88xx_LinuxI2CAdapter::transfer(struct i2c_msg *msgs, uint32_t count,
+                                       uint32_t *latency) {
+  uint64_t start = nanos();
+  bool ok;
+
+  if (_transfer) {
+    ok = _transfer(_context, msgs, count);
+  } else if (_fd >= 0) {
+    struct i2c_rdwr_ioctl_data data;
+    data.msgs = msgs;
+    data.nmsgs = count;
+    ok = ioctl(_fd, I2C_RDWR, &data) == (int)count;
+  } else {
+    ok = false;
+  }
+
+  uint64_t took = nanos() - start;
+  *latency = took > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32_t)took;
+  return ok;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Transfer function serving i2c_msg lists from the simulated
+   sensors on a host bus, for running AMG88xx_LinuxI2CBus without hardware
+    @param  wire the TwoWire the simulators are attached to
+    @param  msgs the messages
+    @param  count number of messages
+    @returns True if a simulator answered every message
+*/
+/**************************************************************************/
+bool AMG88xx_simulatorTransfer(void *wire, struct i2c_msg *msgs,
+                               uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    AMG88xx_Simulator *sim = ((TwoWire *)wire)->device(msgs[i].addr);
+    if (!sim)
+      return false;
+    sim->update(millis());
+    bool ok = (msgs[i].flags & I2C_M_RD) ? sim->read(msgs[i].buf, msgs[i].len)
+                                         : sim->write(msgs[i].buf, msgs[i].len);
+    if (!ok)
+      return false;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Attach to a sensor on an opened adapter
+    @param  addr the I2C address the sensor can be found on
+    @param  adapter the adapter, which may be shared with other sensors
+    @returns True if the sensor answered
+*/
+/**************************************************************************/
+bool AMG88xx_LinuxI2CBus::begin(uint8_t addr,
+                                AMG88xx_LinuxI2CAdapter *adapter) {
+  _addr = addr;
+  _adapter = adapter;
+  if (!_adapter)
+    return false;
+
+  uint8_t pctl;
+  return read(AMG88xx_PCTL, &pctl, 1);
+}
+
+/**************************************************************************/
+/*!
+    @brief  read consecutive registers as a pointer write and a read joined
+   by a repeated start, in one kernel call
+    @param  reg the first register
+    @param  buf where to place the data
+    @param  num the number of bytes to read
+    @returns True on success
+*/
+/**************************************************************************/
+bool AMG88xx_LinuxI2CBus::read(uint8_t reg, uint8_t *buf, uint8_t num) {
+  struct i2c_msg msgs[2];
+  msgs[0].addr = _addr;
+  msgs[0].flags = 0;
+  msgs[0].len = 1;
+  msgs[0].buf = &reg;
+  msgs[1].addr = _addr;
+  msgs[1].flags = I2C_M_RD;
+  msgs[1].len = num;
+  msgs[1].buf = buf;
+  return transfer(msgs, 2);
+}
+
+/**************************************************************************/
+/*!
+    @brief  write consecutive registers in one transfer
+    @param  reg the first register
+    @param  buf the data to write
+    @param  num the number of bytes to write
+    @returns True on success
+*/
+/**************************************************************************/
+bool AMG88xx_LinuxI2CBus::write(uint8_t reg, const uint8_t *buf,
+                                uint8_t num) {
+  uint8_t data[256];
+  data[0] = reg;
+  for (uint8_t i = 0; i < num; i++)
+    data[i + 1] = buf[i];
+
+  struct i2c_msg msg;
+  msg.addr = _addr;
+  msg.flags = 0;
+  msg.len = num + 1;
+  msg.buf = data;
+  return transfer(&msg, 1);
+}
+
+// one call on the adapter, keeping track of its latency
+bool AMG88xx_LinuxI2CBus::transfer(struct i2c_msg *msgs, uint32_t count) {
+  uint32_t latency;
+  bool ok = _adapter->transfer(msgs, count, &latency);
+
+  _lastLatency = latency;
+  if (latency > _maxLatency)
+    _maxLatency = latency;
+  _totalLatency += latency;
+  _calls++;
+  return ok;
+}
+
+#endif
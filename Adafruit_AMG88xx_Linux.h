@@ -0,0 +1,108 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_LINUX_H
+#define LIB_ADAFRUIT_AMG88XX_LINUX_H
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "Adafruit_AMG88xx.h"
+
+#include <linux/i2c.h>
+
+/*!
+    @brief  Carries out one combined I2C transaction
+    @param  context whatever was passed to AMG88xx_LinuxI2CAdapter::open()
+    @param  msgs the messages, with a repeated start between them
+    @param  count number of messages
+    @returns True if every message was acknowledged
+*/
+typedef bool (*AMG88xx_I2CTransfer)(void *context, struct i2c_msg *msgs,
+                                    uint32_t count);
+
+bool AMG88xx_simulatorTransfer(void *wire, struct i2c_msg *msgs,
+                               uint32_t count);
+
+/**************************************************************************/
+/*!
+    @brief  One Linux I2C adapter, /dev/i2c-N. Every transaction is a single
+   I2C_RDWR ioctl and carries its own device address, so any number of
+   sensors can share the one file descriptor.
+
+   For testing, the adapter can run on a transfer function instead of a
+   device node; AMG88xx_simulatorTransfer() routes the same i2c_msg lists
+   to the simulated sensors on a host TwoWire.
+*/
+/**************************************************************************/
+class AMG88xx_LinuxI2CAdapter {
+public:
+  AMG88xx_LinuxI2CAdapter(void) {}
+  ~AMG88xx_LinuxI2CAdapter(void) { close(); }
+  AMG88xx_LinuxI2CAdapter(const AMG88xx_LinuxI2CAdapter &) = delete;
+  AMG88xx_LinuxI2CAdapter &operator=(const AMG88xx_LinuxI2CAdapter &) = delete;
+
+  bool open(const char *path);
+  bool open(AMG88xx_I2CTransfer transfer, void *context);
+  void close();
+
+  bool transfer(struct i2c_msg *msgs, uint32_t count, uint32_t *latency);
+
+private:
+  int _fd = -1;
+  AMG88xx_I2CTransfer _transfer = NULL;
+  void *_context = NULL;
+};
+
+/**************************************************************************/
+/*!
+    @brief  Bus policy reaching one sensor through a Linux I2C adapter. A
+   register read is a pointer write and the data read combined in one
+   kernel call, whatever its length.
+
+   Each call's latency, from entering the kernel to getting the result
+   back, is kept per sensor.
+*/
+/**************************************************************************/
+class AMG88xx_LinuxI2CBus {
+public:
+  bool begin(uint8_t addr, AMG88xx_LinuxI2CAdapter *adapter);
+  bool read(uint8_t reg, uint8_t *buf, uint8_t num);
+  bool write(uint8_t reg, const uint8_t *buf, uint8_t num);
+
+  /*! @brief wait for the sensor @param ms the time in milliseconds */
+  void delay(uint32_t ms) { ::delay(ms); }
+
+  /*! @brief largest read done in one transfer @returns the size in bytes */
+  uint8_t maxTransfer() { return 255; }
+
+  /*! @brief latency of the last call @returns the time in nanoseconds */
+  uint32_t lastLatency() const { return _lastLatency; }
+  /*! @brief worst latency so far @returns the time in nanoseconds */
+  uint32_t maxLatency() const { return _maxLatency; }
+  /*! @brief number of calls so far @returns the count */
+  uint32_t calls() const { return _calls; }
+  /*! @brief mean latency so far @returns the time in nanoseconds */
+  uint32_t meanLatency() const {
+    return _calls ? (uint32_t)(_totalLatency / _calls) : 0;
+  }
+  /*! @brief forget the latencies seen so far */
+  void resetLatency() {
+    _lastLatency = _maxLatency = _calls = 0;
+    _totalLatency = 0;
+  }
+
+private:
+  bool transfer(struct i2c_msg *msgs, uint32_t count);
+
+  AMG88xx_LinuxI2CAdapter *_adapter = NULL;
+  uint8_t _addr = AMG88xx_ADDRESS;
+
+  uint32_t _lastLatency = 0;
+  uint32_t _maxLatency = 0;
+  uint32_t _calls = 0;
+  uint64_t _totalLatency = 0;
+};
+
+/*! @brief the driver on a Linux I2C adapter */
+typedef Adafruit_AMG88xx_Driver<AMG88xx_LinuxI2CBus> Adafruit_AMG88xx_Linux;
+
+#endif
+
+#endif
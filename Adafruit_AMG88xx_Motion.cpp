@@ -0,0 +1,82 @@
+#include "Adafruit_AMG88xx_Motion.h"
+
+/**************************************************************************/
+/*!
+    @brief  Create a motion detector
+    @param  thresholdMul a pixel moves when its change is more than this
+   many times the noise level. Default is 4.
+    @param  minThreshold a pixel never moves on a change of this many raw
+   counts or less. Default is 2, or half a degree.
+    @param  referenceShift 0, the default, compares each frame with the
+   previous one. Higher values compare with an average that follows at
+   1 / 2^referenceShift per frame, which catches slower movement.
+*/
+/**************************************************************************/
+AMG88xx_Motion::AMG88xx_Motion(uint8_t thresholdMul, uint8_t minThreshold,
+                               uint8_t referenceShift)
+    : _noise(16), _thresholdMul(thresholdMul), _minThreshold(minThreshold),
+      _refShift(referenceShift) {}
+
+/**************************************************************************/
+/*!
+    @brief  Forget the reference frame. The next frame passed to update()
+   becomes the new reference.
+*/
+/**************************************************************************/
+void AMG88xx_Motion::reset() {
+  _primed = false;
+  _motion = 0;
+  _energy = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Compare a frame with the reference and update it
+    @param  raw a raw frame from Adafruit_AMG88xx::readPixelsRaw
+    @returns the motion mask
+*/
+/**************************************************************************/
+uint64_t AMG88xx_Motion::update(const int16_t *raw) {
+  if (!_primed) {
+    for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++)
+      _ref[i] = raw[i] << 4;
+    _primed = true;
+    return 0;
+  }
+
+  uint16_t threshold =
+      max((uint16_t)(_noise * _thresholdMul), (uint16_t)(_minThreshold << 4));
+
+  uint64_t motion = 0;
+  uint32_t energy = 0;
+  uint32_t stillSum = 0;
+  uint8_t still = 0;
+
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++) {
+    int16_t cur = raw[i] << 4;
+    int32_t diff = (int32_t)cur - _ref[i];
+    uint16_t absDiff = min((uint32_t)(diff < 0 ? -diff : diff),
+                           (uint32_t)0xFFFF);
+
+    if (absDiff > threshold) {
+      motion |= (uint64_t)1 << i;
+      energy += absDiff;
+    } else {
+      stillSum += absDiff;
+      still++;
+    }
+
+    _ref[i] = _refShift ? _ref[i] + (diff >> _refShift) : cur;
+  }
+
+  // follow the noise of the still pixels at 1/16 per frame
+  if (still) {
+    int16_t level = stillSum / still;
+    _noise += (level - (int16_t)_noise) >> 4;
+    _noise = max(_noise, (uint16_t)1);
+  }
+
+  _motion = motion;
+  _energy = energy >> 4;
+  return motion;
+}
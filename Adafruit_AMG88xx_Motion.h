@@ -0,0 +1,50 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_MOTION_H
+#define LIB_ADAFRUIT_AMG88XX_MOTION_H
+
+#include "Adafruit_AMG88xx.h"
+
+/**************************************************************************/
+/*!
+    @brief  Flags pixels that changed since the last frame by more than the
+   sensor noise. The noise level is learned from the pixels that did not
+   move, so the threshold follows the sensor and the frame rate.
+
+   Motion masks have bit n set for pixel n, see Adafruit_AMG88xx_Bitboard.h.
+*/
+/**************************************************************************/
+class AMG88xx_Motion {
+public:
+  AMG88xx_Motion(uint8_t thresholdMul = 4, uint8_t minThreshold = 2,
+                 uint8_t referenceShift = 0);
+
+  void reset();
+  uint64_t update(const int16_t *raw);
+
+  /*! @brief the motion mask of the last frame @returns the mask */
+  uint64_t motion() const { return _motion; }
+
+  /*!
+      @brief  total change of the moving pixels in the last frame
+      @returns the sum of their differences in raw counts
+  */
+  uint32_t energy() const { return _energy; }
+
+  /*!
+      @brief  the learned noise level
+      @returns the mean absolute frame difference of still pixels, in 1/16
+   raw counts
+  */
+  uint16_t noise() const { return _noise; }
+
+private:
+  int16_t _ref[AMG88xx_PIXEL_ARRAY_SIZE]; // raw counts, 4 fraction bits
+  uint64_t _motion = 0;
+  uint32_t _energy = 0;
+  uint16_t _noise;       // 4 fraction bits
+  uint8_t _thresholdMul; // moving above _thresholdMul times the noise
+  uint8_t _minThreshold; // raw counts
+  uint8_t _refShift;     // reference follows at 1 / 2^_refShift per frame
+  bool _primed = false;
+};
+
+#endif
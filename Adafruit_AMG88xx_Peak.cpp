@@ -0,0 +1,93 @@
+#include "Adafruit_AMG88xx_Peak.h"
+
+// vertex of the parabola through (-1, l), (0, c), (1, r) in 1/256 pixels
+static int16_t vertexOffset(int16_t l, int16_t c, int16_t r) {
+  int16_t denom = l - 2 * c + r;
+  if (denom >= 0) // flat or not a maximum, stay on the pixel
+    return 0;
+  return ((int32_t)(l - r) * 128) / denom;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Find the hottest pixel and fit a parabola through it and its
+   neighbours along each axis. On the edge of the frame the position is not
+   refined along the axis with a missing neighbour.
+    @param  raw a raw frame from Adafruit_AMG88xx::readPixelsRaw
+    @param  peak the peak to fill in
+*/
+/**************************************************************************/
+void AMG88xx_findPeak(const int16_t *raw, AMG88xx_Peak *peak) {
+  uint8_t best = 0;
+  for (uint8_t i = 1; i < AMG88xx_PIXEL_ARRAY_SIZE; i++) {
+    if (raw[i] > raw[best])
+      best = i;
+  }
+
+  uint8_t col = best & 0x07;
+  uint8_t row = best >> 3;
+  int16_t c = raw[best];
+  int16_t dx = 0, dy = 0;
+  int32_t value = (int32_t)c << 4;
+
+  if (col > 0 && col < AMG88xx_PIXEL_COLS - 1) {
+    int16_t l = raw[best - 1], r = raw[best + 1];
+    dx = vertexOffset(l, c, r);
+    // height of the parabola at its vertex, c - (l - r) * dx / 4
+    value -= ((int32_t)(l - r) * dx) >> 6;
+  }
+  if (row > 0 && row < AMG88xx_PIXEL_ROWS - 1) {
+    int16_t u = raw[best - AMG88xx_PIXEL_COLS];
+    int16_t d = raw[best + AMG88xx_PIXEL_COLS];
+    dy = vertexOffset(u, c, d);
+    value -= ((int32_t)(u - d) * dy) >> 6;
+  }
+
+  peak->index = best;
+  peak->x = ((int16_t)col << 8) + dx;
+  peak->y = ((int16_t)row << 8) + dy;
+  peak->value = value;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Create a peak tracker
+    @param  smoothShift the position moves 1 / 2^smoothShift of the way to
+   each new peak. Default is 2.
+    @param  jump a peak further than this from the smoothed position, in
+   1/256 pixels, is a new hotspot and is taken as is. Default is 2 pixels.
+*/
+/**************************************************************************/
+AMG88xx_PeakTracker::AMG88xx_PeakTracker(uint8_t smoothShift, uint16_t jump)
+    : _shift(smoothShift), _jump(jump) {}
+
+/**************************************************************************/
+/*!
+    @brief  Locate the peak in a new frame and update the smoothed position
+    @param  raw a raw frame from Adafruit_AMG88xx::readPixelsRaw
+    @returns the smoothed peak. The temperature is not smoothed.
+*/
+/**************************************************************************/
+const AMG88xx_Peak &AMG88xx_PeakTracker::update(const int16_t *raw) {
+  AMG88xx_Peak found;
+  AMG88xx_findPeak(raw, &found);
+
+  int32_t x = (int32_t)found.x << 8;
+  int32_t y = (int32_t)found.y << 8;
+  int32_t dx = x - _x, dy = y - _y;
+  int32_t jump = (int32_t)_jump << 8;
+
+  if (!_primed || dx > jump || dx < -jump || dy > jump || dy < -jump) {
+    _x = x;
+    _y = y;
+    _primed = true;
+  } else {
+    _x += dx >> _shift;
+    _y += dy >> _shift;
+  }
+
+  _peak = found;
+  _peak.x = _x >> 8;
+  _peak.y = _y >> 8;
+  return _peak;
+}
@@ -0,0 +1,44 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_PEAK_H
+#define LIB_ADAFRUIT_AMG88XX_PEAK_H
+
+#include "Adafruit_AMG88xx.h"
+
+/**************************************************************************/
+/*!
+    @brief  The hottest spot in a frame, located to a fraction of a pixel
+*/
+/**************************************************************************/
+struct AMG88xx_Peak {
+  uint8_t index; ///< the hottest pixel
+  int16_t x;     ///< column of the fitted peak, in 1/256 pixels
+  int16_t y;     ///< row of the fitted peak, in 1/256 pixels
+  int16_t value; ///< fitted peak temperature, in 1/16 raw counts
+};
+
+void AMG88xx_findPeak(const int16_t *raw, AMG88xx_Peak *peak);
+
+/**************************************************************************/
+/*!
+    @brief  Follows the hottest spot across frames, smoothing its position
+   so it can be used for aiming. Jumps to a new hotspot immediately.
+*/
+/**************************************************************************/
+class AMG88xx_PeakTracker {
+public:
+  AMG88xx_PeakTracker(uint8_t smoothShift = 2, uint16_t jump = 2 << 8);
+
+  const AMG88xx_Peak &update(const int16_t *raw);
+
+  /*! @brief the smoothed peak after the last update() @returns the peak */
+  const AMG88xx_Peak &peak() const { return _peak; }
+
+private:
+  AMG88xx_Peak _peak;
+  int32_t _x = 0; // 1/256 pixels, 8 more fraction bits
+  int32_t _y = 0;
+  uint8_t _shift;
+  uint16_t _jump;
+  bool _primed = false;
+};
+
+#endif
@@ -0,0 +1,223 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_PROFILER_H
+#define LIB_ADAFRUIT_AMG88XX_PROFILER_H
+
+/*=========================================================================
+    STAGE PROFILING
+    -----------------------------------------------------------------------
+    Define AMG88xx_PROFILE in the build flags, or before the first include
+    of Adafruit_AMG88xx.h in a sketch, to time where each frame goes. The
+    driver times its bus reads and pixel decoding; sketches time their own
+    stages and close every frame:
+
+      AMG88xx_PROFILE_START(AMG88xx_STAGE_PROCESS);
+      ...
+      AMG88xx_PROFILE_STOP(AMG88xx_STAGE_PROCESS);
+      AMG88xx_PROFILE_FRAME();
+      AMG88xx_PROFILE_PRINT(Serial);
+
+    Times are counted in CPU cycles on Cortex-M3 and up, in nanoseconds on
+    the host and in microseconds everywhere else. Without AMG88xx_PROFILE
+    the macros compile to nothing.
+    -----------------------------------------------------------------------*/
+
+enum profile_stages {
+  AMG88xx_STAGE_BUS,
+  AMG88xx_STAGE_DECODE,
+  AMG88xx_STAGE_PROCESS,
+  AMG88xx_STAGE_RENDER,
+  AMG88xx_STAGE_COUNT
+};
+
+#ifndef AMG88xx_PROFILE_WINDOW
+#define AMG88xx_PROFILE_WINDOW 32 ///< frames per min/avg/max window
+#endif
+
+#if defined(AMG88xx_PROFILE)
+
+#if !defined(ARDUINO)
+#include <chrono>
+#endif
+
+#if defined(ARDUINO) &&                                                        \
+    (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) ||                  \
+     defined(__ARM_ARCH_8M_MAIN__))
+#define AMG88xx_PROFILE_DWT
+#endif
+
+/**************************************************************************/
+/*!
+    @brief  Timing of one stage over the last completed window, per frame
+*/
+/**************************************************************************/
+struct AMG88xx_StageStats {
+  uint32_t min; ///< quickest frame
+  uint32_t avg; ///< mean over the window
+  uint32_t max; ///< slowest frame
+};
+
+/**************************************************************************/
+/*!
+    @brief  Collects stage timings. Time spent in a stage is summed over a
+   frame, and each frame's sums go into a window of AMG88xx_PROFILE_WINDOW
+   frames. Windows do not overlap: the statistics change once a window
+   fills, and then cover only that window.
+*/
+/**************************************************************************/
+class AMG88xx_Profiler {
+public:
+  AMG88xx_Profiler(void) {
+#if defined(AMG88xx_PROFILE_DWT)
+    // enable the cycle counter: DEMCR.TRCENA, then DWT_CTRL.CYCCNTENA
+    *(volatile uint32_t *)0xE000EDFC |= 1UL << 24;
+    *(volatile uint32_t *)0xE0001000 |= 1;
+#endif
+  }
+
+  /*!
+      @brief  the current time, for starting a stage. Unlike now() it needs
+     the profiler, so the cycle counter is running before the first sample.
+      @returns ticks of unit()
+  */
+  uint32_t start() const { return now(); }
+
+  /*! @brief the current time @returns ticks of unit() */
+  static uint32_t now() {
+#if defined(AMG88xx_PROFILE_DWT)
+    return *(volatile uint32_t *)0xE0001004;
+#elif defined(ARDUINO)
+    return micros();
+#else
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+  }
+
+  /*! @brief what now() counts @returns the unit name */
+  static const char *unit() {
+#if defined(AMG88xx_PROFILE_DWT)
+    return "cycles";
+#elif defined(ARDUINO)
+    return "us";
+#else
+    return "ns";
+#endif
+  }
+
+  /*!
+      @brief  add time spent in a stage to the current frame
+      @param  stage one of profile_stages
+      @param  ticks the time spent
+  */
+  void add(uint8_t stage, uint32_t ticks) { _frame[stage] += ticks; }
+
+  /*! @brief close the current frame */
+  void frame() {
+    for (uint8_t s = 0; s < AMG88xx_STAGE_COUNT; s++) {
+      uint32_t t = _frame[s];
+      _frame[s] = 0;
+      if (!_frames || t < _min[s])
+        _min[s] = t;
+      if (!_frames || t > _max[s])
+        _max[s] = t;
+      _sum[s] += t;
+    }
+
+    if (++_frames < AMG88xx_PROFILE_WINDOW)
+      return;
+
+    for (uint8_t s = 0; s < AMG88xx_STAGE_COUNT; s++) {
+      _stats[s].min = _min[s];
+      _stats[s].avg = _sum[s] / _frames;
+      _stats[s].max = _max[s];
+      _sum[s] = 0;
+    }
+    _frames = 0;
+    _windows++;
+  }
+
+  /*!
+      @brief  timing of a stage over the last completed window
+      @param  stage one of profile_stages
+      @returns the timing
+  */
+  const AMG88xx_StageStats &stats(uint8_t stage) const {
+    return _stats[stage];
+  }
+
+  /*! @brief number of windows completed @returns the count */
+  uint32_t windows() const { return _windows; }
+
+  /*!
+      @brief  print the last window, one line per stage as
+     "stage min/avg/max unit"
+      @param  out where to print, for example Serial
+  */
+  void print(Print &out) const {
+    static const char *const names[] = {"bus", "decode", "process", "render"};
+    for (uint8_t s = 0; s < AMG88xx_STAGE_COUNT; s++) {
+      write(out, names[s]);
+      write(out, " ");
+      write(out, _stats[s].min);
+      write(out, "/");
+      write(out, _stats[s].avg);
+      write(out, "/");
+      write(out, _stats[s].max);
+      write(out, " ");
+      write(out, unit());
+      write(out, "\r\n");
+    }
+  }
+
+private:
+  static void write(Print &out, const char *s) {
+    out.write((const uint8_t *)s, strlen(s));
+  }
+
+  static void write(Print &out, uint32_t v) {
+    char buf[11];
+    char *p = buf + sizeof(buf);
+    *--p = 0;
+    do {
+      *--p = '0' + v % 10;
+      v /= 10;
+    } while (v);
+    write(out, p);
+  }
+
+  uint32_t _frame[AMG88xx_STAGE_COUNT] = {};
+  uint32_t _min[AMG88xx_STAGE_COUNT] = {};
+  uint32_t _max[AMG88xx_STAGE_COUNT] = {};
+  uint32_t _sum[AMG88xx_STAGE_COUNT] = {};
+  AMG88xx_StageStats _stats[AMG88xx_STAGE_COUNT] = {};
+  uint16_t _frames = 0;
+  uint32_t _windows = 0;
+};
+
+/*!
+    @brief  the profiler shared by the driver and the sketch
+    @returns the profiler
+*/
+inline AMG88xx_Profiler &AMG88xx_profiler() {
+  static AMG88xx_Profiler profiler;
+  return profiler;
+}
+
+#define AMG88xx_PROFILE_START(stage)                                           \
+  uint32_t AMG88xx_profileStart_##stage = AMG88xx_profiler().start()
+#define AMG88xx_PROFILE_STOP(stage)                                            \
+  AMG88xx_profiler().add(stage, AMG88xx_Profiler::now() -                      \
+                                    AMG88xx_profileStart_##stage)
+#define AMG88xx_PROFILE_FRAME() AMG88xx_profiler().frame()
+#define AMG88xx_PROFILE_PRINT(out) AMG88xx_profiler().print(out)
+
+#else
+
+#define AMG88xx_PROFILE_START(stage)
+#define AMG88xx_PROFILE_STOP(stage)
+#define AMG88xx_PROFILE_FRAME()
+#define AMG88xx_PROFILE_PRINT(out)
+
+#endif
+
+#endif
@@ -0,0 +1,190 @@
+#include "Adafruit_AMG88xx_Recording.h"
+
+#include <string.h>
+
+// an interrupt level in raw counts, as the driver writes it
+static int16_t levelCounts(float level) {
+  int conv = level / AMG88xx_PIXEL_TEMP_CONVERSION;
+  return constrain(conv, -2048, 2047);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start a recording by writing its header
+    @param  out where to write the recording
+    @param  profile the configuration the sensor runs with
+    @param  address the I2C address of the sensor
+    @param  index Optional array to build the frame index in, written out
+   by end()
+    @param  indexSize number of entries index can hold
+    @returns True if the header was written
+*/
+/**************************************************************************/
+bool AMG88xx_RecordingWriter::begin(Print *out, const AMG88xx_Profile &profile,
+                                    uint8_t address, uint32_t *index,
+                                    uint16_t indexSize) {
+  _out = out;
+  _frames = 0;
+  _index = indexSize ? index : NULL;
+  _indexSize = indexSize;
+  _indexCount = 0;
+  _stride = 1;
+
+  AMG88xx_RecordingHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, AMG88xx_RECORDING_MAGIC, sizeof(header.magic));
+  header.version = AMG88xx_RECORDING_VERSION;
+  header.headerSize = sizeof(AMG88xx_RecordingHeader);
+  header.frameSize = sizeof(AMG88xx_RecordedFrame);
+  header.address = address;
+  header.frameRate = profile.frameRate;
+  header.movingAverage = profile.movingAverage;
+  header.interruptMode = profile.interruptMode;
+  header.interruptEnable = profile.interruptEnable;
+  header.interruptHigh = levelCounts(profile.interruptHigh);
+  header.interruptLow = levelCounts(profile.interruptLow);
+  header.interruptHysteresis = levelCounts(profile.interruptHysteresis);
+  header.startTime = millis();
+
+  return _out->write((const uint8_t *)&header, sizeof(header)) ==
+         sizeof(header);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Append one frame
+    @param  raw the frame as read with Adafruit_AMG88xx::readRawFrame()
+    @param  timestamp when the frame was read, in milliseconds
+    @returns True if the whole record was written
+*/
+/**************************************************************************/
+bool AMG88xx_RecordingWriter::write(const AMG88xx_RawFrame &raw,
+                                    uint32_t timestamp) {
+  if (_index && _frames % _stride == 0) {
+    if (_indexCount == _indexSize) {
+      // full, keep every other entry
+      for (uint16_t i = 0; i < _indexCount; i += 2)
+        _index[i >> 1] = _index[i];
+      _indexCount = (_indexCount + 1) >> 1;
+      _stride <<= 1;
+    }
+    if (_frames % _stride == 0)
+      _index[_indexCount++] = timestamp;
+  }
+
+  // written in place to avoid a copy of the frame
+  uint32_t head[2] = {timestamp, _frames};
+  uint8_t tail[2] = {0, 0};
+  bool ok = _out->write((const uint8_t *)head, sizeof(head)) == sizeof(head) &&
+            _out->write((const uint8_t *)&raw, sizeof(raw)) == sizeof(raw) &&
+            _out->write(tail, sizeof(tail)) == sizeof(tail);
+
+  _frames++;
+  return ok;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Finish the recording, writing the frame index if there is one
+    @returns True if everything was written
+*/
+/**************************************************************************/
+bool AMG88xx_RecordingWriter::end() {
+  if (!_index)
+    return true;
+
+  AMG88xx_RecordingIndex footer;
+  footer.frames = _frames;
+  footer.stride = _stride;
+  footer.count = _indexCount;
+  memcpy(footer.magic, AMG88xx_RECORDING_INDEX_MAGIC, sizeof(footer.magic));
+
+  size_t bytes = (size_t)_indexCount * sizeof(uint32_t);
+  return _out->write((const uint8_t *)_index, bytes) == bytes &&
+         _out->write((const uint8_t *)&footer, sizeof(footer)) ==
+             sizeof(footer);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Check a recording and locate its frames and index
+    @param  data the recording, 4 byte aligned
+    @param  size the size of the recording in bytes
+    @returns True if data holds a recording this reader understands
+*/
+/**************************************************************************/
+bool AMG88xx_RecordingReader::begin(const uint8_t *data, size_t size) {
+  _data = NULL;
+  _frames = 0;
+  _index = NULL;
+
+  const AMG88xx_RecordingHeader *h = (const AMG88xx_RecordingHeader *)data;
+  if (size < sizeof(*h) || memcmp(h->magic, AMG88xx_RECORDING_MAGIC, 4) ||
+      h->version != AMG88xx_RECORDING_VERSION ||
+      h->headerSize < sizeof(*h) || h->headerSize > size ||
+      h->frameSize < sizeof(AMG88xx_RecordedFrame) || h->frameSize & 0x03)
+    return false;
+
+  _data = data;
+  size_t body = size - h->headerSize;
+  _frames = body / h->frameSize;
+
+  if (body < sizeof(AMG88xx_RecordingIndex))
+    return true;
+
+  // an index is only trusted if it accounts for every byte
+  const AMG88xx_RecordingIndex *footer =
+      (const AMG88xx_RecordingIndex *)(data + size - sizeof(*footer));
+  if (memcmp(footer->magic, AMG88xx_RECORDING_INDEX_MAGIC, 4) ||
+      !footer->stride)
+    return true;
+  size_t expected = (size_t)footer->frames * h->frameSize +
+                    (size_t)footer->count * sizeof(uint32_t) + sizeof(*footer);
+  if (expected != body)
+    return true;
+
+  _frames = footer->frames;
+  _stride = footer->stride;
+  _indexCount = footer->count;
+  _index = (const uint32_t *)(data + h->headerSize +
+                              (size_t)_frames * h->frameSize);
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Find the first frame at or after a point in time. Timestamps
+   are taken to never go backwards.
+    @param  timestamp the time in milliseconds
+    @returns the frame number, or frames() if every frame is earlier
+*/
+/**************************************************************************/
+uint32_t AMG88xx_RecordingReader::find(uint32_t timestamp) const {
+  uint32_t lo = 0, hi = _frames;
+
+  if (_index) {
+    // narrow down to the frames between two index entries
+    uint32_t a = 0, b = _indexCount;
+    while (a < b) {
+      uint32_t m = (a + b) >> 1;
+      if (_index[m] < timestamp)
+        a = m + 1;
+      else
+        b = m;
+    }
+    if (a > 0)
+      lo = (a - 1) * _stride;
+    if (a < _indexCount)
+      hi = a * _stride;
+  }
+
+  while (lo < hi) {
+    uint32_t m = lo + ((hi - lo) >> 1);
+    if (frame(m)->timestamp < timestamp)
+      lo = m + 1;
+    else
+      hi = m;
+  }
+  return lo;
+}
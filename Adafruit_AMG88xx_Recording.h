@@ -0,0 +1,163 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_RECORDING_H
+#define LIB_ADAFRUIT_AMG88XX_RECORDING_H
+
+#include "Adafruit_AMG88xx.h"
+
+/*=========================================================================
+    RECORDING FORMAT
+    -----------------------------------------------------------------------
+    A recording is a header, fixed size frame records and optionally a
+    frame index, all little endian:
+
+      AMG88xx_RecordingHeader     headerSize bytes
+      AMG88xx_RecordedFrame       frameSize bytes, repeated
+      uint32_t timestamps[count]  optional, see AMG88xx_RecordingIndex
+      AMG88xx_RecordingIndex      optional
+
+    Frames keep the sensor's register bytes, so storing one costs no
+    decoding and reading one is a pointer into the file. Frame n starts at
+    headerSize + n * frameSize, and a recording cut short still reads up to
+    its last complete frame.
+    -----------------------------------------------------------------------*/
+#define AMG88xx_RECORDING_MAGIC "AMGR"
+#define AMG88xx_RECORDING_INDEX_MAGIC "AMGI"
+#define AMG88xx_RECORDING_VERSION 1
+/*=========================================================================*/
+
+/**************************************************************************/
+/*!
+    @brief  Start of a recording, describing the sensor configuration
+*/
+/**************************************************************************/
+struct AMG88xx_RecordingHeader {
+  char magic[4];               ///< AMG88xx_RECORDING_MAGIC
+  uint16_t version;            ///< AMG88xx_RECORDING_VERSION
+  uint16_t headerSize;         ///< offset of the first frame
+  uint16_t frameSize;          ///< size of each frame record
+  uint8_t address;             ///< I2C address of the sensor
+  uint8_t frameRate;           ///< one of frame_rates
+  uint8_t movingAverage;       ///< twice moving average mode
+  uint8_t interruptMode;       ///< one of int_modes
+  uint8_t interruptEnable;     ///< INT pin driven
+  uint8_t reserved0;           ///< zero
+  int16_t interruptHigh;       ///< upper level in raw pixel counts
+  int16_t interruptLow;        ///< lower level in raw pixel counts
+  int16_t interruptHysteresis; ///< hysteresis in raw pixel counts
+  uint16_t reserved1;          ///< zero
+  uint32_t startTime;          ///< millis() when recording started
+  uint32_t reserved2;          ///< zero
+};
+
+/**************************************************************************/
+/*!
+    @brief  One recorded frame
+*/
+/**************************************************************************/
+struct AMG88xx_RecordedFrame {
+  uint32_t timestamp;   ///< millis() when the frame was read
+  uint32_t sequence;    ///< frame number, gaps mean lost frames
+  AMG88xx_RawFrame raw; ///< the thermistor and pixel registers
+  uint8_t reserved[2];  ///< zero
+};
+
+/**************************************************************************/
+/*!
+    @brief  End of an indexed recording. It follows the timestamps of frames
+   0, stride, 2 * stride and so on, which let a reader find a point in time
+   without touching every frame.
+*/
+/**************************************************************************/
+struct AMG88xx_RecordingIndex {
+  uint32_t frames; ///< number of frames in the recording
+  uint32_t stride; ///< frames between index entries
+  uint32_t count;  ///< number of index entries
+  char magic[4];   ///< AMG88xx_RECORDING_INDEX_MAGIC
+};
+
+static_assert(sizeof(AMG88xx_RecordingHeader) == 32, "header layout");
+static_assert(sizeof(AMG88xx_RecordedFrame) == 140, "frame layout");
+static_assert(sizeof(AMG88xx_RecordingIndex) == 16, "index layout");
+
+/**************************************************************************/
+/*!
+    @brief  Writes a recording to any Print, for example an SD card File or
+   Serial. The optional index is kept in a caller supplied array; when it
+   fills up every other entry is dropped and the stride doubles, so any
+   length of recording fits.
+*/
+/**************************************************************************/
+class AMG88xx_RecordingWriter {
+public:
+  bool begin(Print *out, const AMG88xx_Profile &profile,
+             uint8_t address = AMG88xx_ADDRESS, uint32_t *index = NULL,
+             uint16_t indexSize = 0);
+  bool write(const AMG88xx_RawFrame &raw, uint32_t timestamp);
+  bool end();
+
+  /*!
+      @brief  Read a frame from a sensor and record it
+      @param  sensor the sensor
+      @returns True if the frame was read and written
+  */
+  template <class Bus> bool record(Adafruit_AMG88xx_Driver<Bus> &sensor) {
+    AMG88xx_RawFrame raw;
+    return sensor.readRawFrame(&raw) && write(raw, millis());
+  }
+
+  /*! @brief number of frames written @returns the count */
+  uint32_t frames() const { return _frames; }
+
+private:
+  Print *_out = NULL;
+  uint32_t _frames = 0;
+
+  uint32_t *_index = NULL;
+  uint16_t _indexSize = 0;
+  uint16_t _indexCount = 0;
+  uint32_t _stride = 1;
+};
+
+/**************************************************************************/
+/*!
+    @brief  Reads a recording held in memory, for example a loaded or memory
+   mapped file. Nothing is copied or parsed: frames are returned as pointers
+   into the data, which must be 4 byte aligned and stay valid while in use.
+*/
+/**************************************************************************/
+class AMG88xx_RecordingReader {
+public:
+  bool begin(const uint8_t *data, size_t size);
+
+  /*! @brief the recording header @returns the header */
+  const AMG88xx_RecordingHeader *header() const {
+    return (const AMG88xx_RecordingHeader *)_data;
+  }
+
+  /*! @brief number of complete frames @returns the count */
+  uint32_t frames() const { return _frames; }
+
+  /*!
+      @brief  a frame of the recording
+      @param  n the frame number, below frames()
+      @returns the frame
+  */
+  const AMG88xx_RecordedFrame *frame(uint32_t n) const {
+    return (const AMG88xx_RecordedFrame *)(_data + header()->headerSize +
+                                           (size_t)n * header()->frameSize);
+  }
+
+  uint32_t find(uint32_t timestamp) const;
+
+  /*! @brief whether the recording has an index @returns True if indexed */
+  bool indexed() const { return _index != NULL; }
+
+private:
+  const uint8_t *_data = NULL;
+  uint32_t _frames = 0;
+
+  const uint32_t *_index = NULL;
+  uint32_t _indexCount = 0;
+  uint32_t _stride = 0;
+};
+
+#endif
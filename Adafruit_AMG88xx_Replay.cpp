@@ -0,0 +1,173 @@
+#include "Adafruit_AMG88xx_Replay.h"
+
+#if !defined(ARDUINO)
+#include <stdio.h>
+#include <stdlib.h>
+#endif
+
+#if defined(__linux__) && !defined(ARDUINO)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**************************************************************************/
+/*!
+    @brief  Start replaying a recording from its first frame
+    @param  recording the recording, which must stay valid while in use
+    @param  speed 1 to replay in real time, above 1 to speed up by that
+   factor, or AMG88xx_REPLAY_FAST to serve the next frame whenever the
+   thermistor or pixels of the current one are read a second time, and
+   skip all waiting
+    @returns True if the recording holds any frames
+*/
+/**************************************************************************/
+bool AMG88xx_ReplayBus::begin(const AMG88xx_RecordingReader *recording,
+                              float speed) {
+  _recording = recording;
+  _speed = speed;
+  _start = millis();
+  _next = 0;
+  _served = 0;
+  return _recording && _recording->frames();
+}
+
+/**************************************************************************/
+/*!
+    @brief  read consecutive registers, after latching every frame that is
+   due
+    @param  reg the first register
+    @param  buf where to place the data
+    @param  num the number of bytes to read
+    @returns True on success
+*/
+/**************************************************************************/
+bool AMG88xx_ReplayBus::read(uint8_t reg, uint8_t *buf, uint8_t num) {
+  if (_speed == AMG88xx_REPLAY_FAST) {
+    // the frame's data: bit 0 the thermistor, bit 1 the pixels
+    uint8_t touched = 0;
+    if (reg <= AMG88xx_TTHH && reg + num > AMG88xx_TTHL)
+      touched |= 0x01;
+    if (reg + num > AMG88xx_PIXEL_OFFSET)
+      touched |= 0x02;
+    // a frame starts with its first data read, so reading data already
+    // served moves on to the next frame
+    if (touched && (!_next || (_served & touched)) && !finished()) {
+      _sim.latchFrame(_recording->frame(_next++)->raw);
+      _served = 0;
+    }
+    _served |= touched;
+  } else {
+    sync();
+  }
+  return _sim.write(&reg, 1) && _sim.read(buf, num);
+}
+
+/**************************************************************************/
+/*!
+    @brief  write consecutive registers of the simulator
+    @param  reg the first register
+    @param  buf the data to write
+    @param  num the number of bytes to write
+    @returns True on success
+*/
+/**************************************************************************/
+bool AMG88xx_ReplayBus::write(uint8_t reg, const uint8_t *buf, uint8_t num) {
+  return _sim.write(buf, num, &reg, 1);
+}
+
+/**************************************************************************/
+/*!
+    @brief  wait for the sensor, not at all when replaying as fast as
+   possible
+    @param  ms the time in milliseconds
+*/
+/**************************************************************************/
+void AMG88xx_ReplayBus::delay(uint32_t ms) {
+  if (_speed != AMG88xx_REPLAY_FAST)
+    ::delay(ms);
+}
+
+// latch every frame up to the recording time matching now, in order so the
+// interrupt table sees each of them like the sensor did
+void AMG88xx_ReplayBus::sync() {
+  if (finished())
+    return;
+
+  uint32_t elapsed = (uint32_t)((millis() - _start) * _speed);
+  uint32_t target = _recording->frame(0)->timestamp + elapsed;
+
+  while (!finished() && _recording->frame(_next)->timestamp <= target)
+    _sim.latchFrame(_recording->frame(_next++)->raw);
+}
+
+#if !defined(ARDUINO)
+
+/**************************************************************************/
+/*!
+    @brief  Open a recording, memory mapping it where possible and
+   otherwise loading it
+    @param  path the file
+    @returns True if the file holds a recording
+*/
+/**************************************************************************/
+bool AMG88xx_RecordingFile::open(const char *path) {
+  close();
+
+#if defined(__linux__)
+  int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED) {
+      madvise(map, st.st_size, MADV_SEQUENTIAL);
+      _data = (uint8_t *)map;
+      _size = st.st_size;
+      _mapped = true;
+    }
+  }
+  ::close(fd);
+#endif
+
+  if (!_data) {
+    FILE *f = fopen(path, "rb");
+    if (!f)
+      return false;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    _data = size > 0 ? (uint8_t *)malloc(size) : NULL;
+    if (_data && fread(_data, 1, size, f) == (size_t)size)
+      _size = size;
+    fclose(f);
+  }
+
+  if (!_size || !_reader.begin(_data, _size)) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Release the file
+*/
+/**************************************************************************/
+void AMG88xx_RecordingFile::close() {
+#if defined(__linux__)
+  if (_mapped)
+    munmap(_data, _size);
+  else
+#endif
+    free(_data);
+  _data = NULL;
+  _size = 0;
+  _mapped = false;
+  _reader.begin(NULL, 0);
+}
+
+#endif
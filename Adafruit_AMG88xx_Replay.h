@@ -0,0 +1,88 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_REPLAY_H
+#define LIB_ADAFRUIT_AMG88XX_REPLAY_H
+
+#include "Adafruit_AMG88xx_Recording.h"
+#include "Adafruit_AMG88xx_Simulator.h"
+
+/*! @brief replay speed serving one recorded frame per frame read */
+#define AMG88xx_REPLAY_FAST 0
+
+/**************************************************************************/
+/*!
+    @brief  Bus policy playing a recording back through the driver, so
+   recorded data takes the same readPixels(), readThermistor() and
+   getInterrupt() paths as a live sensor.
+
+   Recorded frames are latched into a simulator, which answers every
+   register access and rebuilds the interrupt table and status flags from
+   the replayed pixels. Frames are paced by their timestamps against
+   millis(), optionally sped up, or served as fast as they are read.
+*/
+/**************************************************************************/
+class AMG88xx_ReplayBus {
+public:
+  bool begin(const AMG88xx_RecordingReader *recording, float speed = 1);
+  bool read(uint8_t reg, uint8_t *buf, uint8_t num);
+  bool write(uint8_t reg, const uint8_t *buf, uint8_t num);
+  void delay(uint32_t ms);
+
+  /*! @brief largest read done in one transfer @returns the size in bytes */
+  uint8_t maxTransfer() { return 255; }
+
+  /*! @brief number of frames replayed so far @returns the count */
+  uint32_t position() const { return _next; }
+  /*!
+      @brief  whether the whole recording has been replayed
+      @returns True once the last frame is latched
+  */
+  bool finished() const { return _recording && _next >= _recording->frames(); }
+
+  /*! @brief the simulator serving the registers @returns the simulator */
+  AMG88xx_Simulator *simulator() { return &_sim; }
+
+private:
+  void sync();
+
+  AMG88xx_Simulator _sim;
+  const AMG88xx_RecordingReader *_recording = NULL;
+  float _speed = 1;
+  uint32_t _start = 0;
+  uint32_t _next = 0;
+  uint8_t _served = 0; // data of the latched frame read so far
+};
+
+#if !defined(ARDUINO)
+
+/**************************************************************************/
+/*!
+    @brief  A recording file opened for reading. On Linux the file is
+   memory mapped, so recordings of any length open instantly and only the
+   frames actually replayed are paged in.
+*/
+/**************************************************************************/
+class AMG88xx_RecordingFile {
+public:
+  AMG88xx_RecordingFile(void) {}
+  ~AMG88xx_RecordingFile(void) { close(); }
+  AMG88xx_RecordingFile(const AMG88xx_RecordingFile &) = delete;
+  AMG88xx_RecordingFile &operator=(const AMG88xx_RecordingFile &) = delete;
+
+  bool open(const char *path);
+  void close();
+
+  /*! @brief the reader over the file @returns the reader */
+  const AMG88xx_RecordingReader *reader() const { return &_reader; }
+
+private:
+  uint8_t *_data = NULL;
+  size_t _size = 0;
+  bool _mapped = false;
+  AMG88xx_RecordingReader _reader;
+};
+
+#endif
+
+/*! @brief the driver replaying a recording */
+typedef Adafruit_AMG88xx_Driver<AMG88xx_ReplayBus> Adafruit_AMG88xx_Replay;
+
+#endif
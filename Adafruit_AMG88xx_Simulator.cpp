@@ -0,0 +1,386 @@
+#include "Adafruit_AMG88xx_Simulator.h"
+#include "Adafruit_AMG88xx.h"
+
+#include <string.h>
+
+// bits of the STAT and SCLR registers
+#define STAT_INTF 0x02
+#define STAT_OVF_IRS 0x04
+#define STAT_OVF_THS 0x08
+
+/**************************************************************************/
+/*!
+    @brief  Create a simulated sensor showing a uniform 25 degree scene
+    @param  addr the I2C address to answer on. Default is 0x69
+*/
+/**************************************************************************/
+AMG88xx_Simulator::AMG88xx_Simulator(uint8_t addr) : _addr(addr) {
+  memset(_regs, 0, sizeof(_regs));
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++) {
+    _scene[i] = 25 / AMG88xx_PIXEL_TEMP_CONVERSION;
+    _last[i] = _scene[i];
+  }
+  _thermistor = 25 / AMG88xx_THERMISTOR_CONVERSION;
+  initialReset();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set what every pixel sees, picked up from the next frame on
+    @param  raw 64 values in raw counts of AMG88xx_PIXEL_TEMP_CONVERSION
+*/
+/**************************************************************************/
+void AMG88xx_Simulator::setScene(const int16_t *raw) {
+  memcpy(_scene, raw, sizeof(_scene));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set what one pixel sees, picked up from the next frame on
+    @param  i the pixel index
+    @param  raw the value in raw counts of AMG88xx_PIXEL_TEMP_CONVERSION
+*/
+/**************************************************************************/
+void AMG88xx_Simulator::setPixel(uint8_t i, int16_t raw) {
+  _scene[i & 0x3F] = raw;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set the board temperature, picked up from the next frame on
+    @param  raw the value in raw counts of AMG88xx_THERMISTOR_CONVERSION
+*/
+/**************************************************************************/
+void AMG88xx_Simulator::setThermistor(int16_t raw) { _thermistor = raw; }
+
+/**************************************************************************/
+/*!
+    @brief  Add uniform random noise to every measured pixel
+    @param  counts noise amplitude, pixels vary by up to +/- counts
+    @param  seed the noise generator seed, for reproducible runs
+*/
+/**************************************************************************/
+void AMG88xx_Simulator::setNoise(uint8_t counts, uint32_t seed) {
+  _noise = counts;
+  _seed = seed ? seed : 1;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Run the frame clock up to a point in time. Frames are only
+   captured in normal mode, every 100 ms at 10 FPS or every second at 1 FPS.
+   If the clock is more than ten frames behind it skips ahead instead of
+   capturing every missed frame.
+    @param  now the current time in milliseconds
+*/
+/**************************************************************************/
+void AMG88xx_Simulator::update(uint32_t now) {
+  if (!_started) {
+    _started = true;
+    _lastFrame = now;
+    return;
+  }
+
+  if (_regs[AMG88xx_PCTL] != AMG88xx_NORMAL_MODE) {
+    _lastFrame = now;
+    return;
+  }
+
+  uint32_t period = (_regs[AMG88xx_FPSC] & 0x01) ? 1000 : 100;
+  if (now - _lastFrame > 10 * period)
+    _lastFrame = now - period;
+
+  while (now - _lastFrame >= period) {
+    capture();
+    _lastFrame += period;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Take a frame as if the sensor had just measured it, for example
+   one from a recording. The registers are loaded as they are, without
+   noise or averaging, and the interrupt logic runs on the new values.
+    @param  frame the thermistor and pixel registers
+*/
+/**************************************************************************/
+void AMG88xx_Simulator::latchFrame(const AMG88xx_RawFrame &frame) {
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++) {
+    uint8_t *reg = &_regs[AMG88xx_PIXEL_OFFSET + (i << 1)];
+    int16_t previous = (int16_t)((((uint16_t)reg[1] << 8) | reg[0]) << 4) >> 4;
+    reg[0] = frame.pixels[i << 1];
+    reg[1] = frame.pixels[(i << 1) + 1] & 0x0F;
+
+    checkInterrupt(i, frame.pixel(i), previous);
+  }
+
+  _regs[AMG88xx_TTHL] = frame.thermistor[0];
+  _regs[AMG88xx_TTHH] = frame.thermistor[1] & 0x0F;
+
+  _frames++;
+}
+
+/**************************************************************************/
+/*!
+    @brief  state of the INT output
+    @returns True while the INT pin is pulled low
+*/
+/**************************************************************************/
+bool AMG88xx_Simulator::interruptAsserted() const {
+  return (_regs[AMG88xx_INTC] & 0x01) && (_regs[AMG88xx_STAT] & STAT_INTF);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Write registers as the chip would, ignoring read-only and
+   reserved registers and acting on RST and SCLR
+    @param  reg the first register
+    @param  buf the values to write
+    @param  len the number of registers to write
+*/
+/**************************************************************************/
+void AMG88xx_Simulator::writeRegisters(uint8_t reg, const uint8_t *buf,
+                                       size_t len) {
+  for (size_t n = 0; n < len; n++, reg++) {
+    uint8_t v = buf[n];
+    switch (reg) {
+    case AMG88xx_PCTL:
+      _regs[reg] = v;
+      break;
+    case AMG88xx_RST:
+      if (v == AMG88xx_FLAG_RESET)
+        flagReset();
+      else if (v == AMG88xx_INITIAL_RESET)
+        initialReset();
+      break;
+    case AMG88xx_FPSC:
+      _regs[reg] = v & 0x01;
+      break;
+    case AMG88xx_INTC:
+      _regs[reg] = v & 0x03;
+      break;
+    case AMG88xx_SCLR:
+      _regs[AMG88xx_STAT] &= ~(v & (STAT_INTF | STAT_OVF_IRS | STAT_OVF_THS));
+      break;
+    case AMG88xx_AVE:
+      _regs[reg] = v & 0x20;
+      break;
+    case AMG88xx_INTHL:
+    case AMG88xx_INTLL:
+    case AMG88xx_IHYSL:
+      _regs[reg] = v;
+      break;
+    case AMG88xx_INTHH:
+    case AMG88xx_INTLH:
+    case AMG88xx_IHYSH:
+      _regs[reg] = v & 0x0F;
+      break;
+    default:
+      // status, thermistor, interrupt table, pixels and reserved
+      break;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Read registers as the chip would
+    @param  reg the first register
+    @param  buf where to place the values
+    @param  len the number of registers to read
+*/
+/**************************************************************************/
+void AMG88xx_Simulator::readRegisters(uint8_t reg, uint8_t *buf, size_t len) {
+  for (size_t n = 0; n < len; n++, reg++)
+    buf[n] = _regs[reg];
+}
+
+/**************************************************************************/
+/*!
+    @brief  An I2C write. The first byte sets the register pointer, the rest
+   are written to consecutive registers.
+    @param  buf the bytes following the prefix
+    @param  len number of bytes in buf
+    @param  prefix optional bytes sent before buf
+    @param  prefixLen number of bytes in prefix
+    @returns True, the simulator always acknowledges
+*/
+/**************************************************************************/
+bool AMG88xx_Simulator::write(const uint8_t *buf, size_t len,
+                              const uint8_t *prefix, size_t prefixLen) {
+  _transactions++;
+  _bytes += len + prefixLen;
+
+  if (prefixLen) {
+    _pointer = prefix[0];
+    // a multi byte prefix carries register data too
+    writeRegisters(_pointer, prefix + 1, prefixLen - 1);
+    _pointer += prefixLen - 1;
+  } else if (len) {
+    _pointer = buf[0];
+    buf++;
+    len--;
+  }
+
+  writeRegisters(_pointer, buf, len);
+  _pointer += len;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  An I2C read, continuing from the register pointer
+    @param  buf where to place the bytes
+    @param  len number of bytes to read
+    @returns True, the simulator always acknowledges
+*/
+/**************************************************************************/
+bool AMG88xx_Simulator::read(uint8_t *buf, size_t len) {
+  _transactions++;
+  _bytes += len;
+
+  readRegisters(_pointer, buf, len);
+  _pointer += len;
+  return true;
+}
+
+// back to power-on settings, keeping the power mode
+void AMG88xx_Simulator::initialReset() {
+  flagReset();
+  _regs[AMG88xx_FPSC] = AMG88xx_FPS_10;
+  _regs[AMG88xx_INTC] = 0;
+  _regs[AMG88xx_AVE] = 0;
+  for (uint8_t reg = AMG88xx_INTHL; reg <= AMG88xx_IHYSH; reg++)
+    _regs[reg] = 0;
+}
+
+// clear status, the interrupt table and re-arm every pixel
+void AMG88xx_Simulator::flagReset() {
+  _regs[AMG88xx_STAT] = 0;
+  for (uint8_t i = 0; i < 8; i++)
+    _regs[AMG88xx_INT_OFFSET + i] = 0;
+  _armed = ~(uint64_t)0;
+}
+
+// a 12 bit two's complement level register pair
+int16_t AMG88xx_Simulator::level(uint8_t reg) const {
+  uint16_t v = ((uint16_t)_regs[reg + 1] << 8) | _regs[reg];
+  return (int16_t)(v << 4) >> 4;
+}
+
+// uniform noise in +/- _noise counts from a xorshift generator
+int16_t AMG88xx_Simulator::noise() {
+  if (!_noise)
+    return 0;
+  _seed ^= _seed << 13;
+  _seed ^= _seed >> 17;
+  _seed ^= _seed << 5;
+  return (int16_t)(_seed % (2 * _noise + 1)) - _noise;
+}
+
+// measure the scene into the output registers
+void AMG88xx_Simulator::capture() {
+  bool average = _regs[AMG88xx_AVE] & 0x20;
+
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++) {
+    int16_t measured = _scene[i] + noise();
+    int16_t out = average ? (measured + _last[i]) / 2 : measured;
+    _last[i] = measured;
+
+    if (out > 2047 || out < -2048) {
+      _regs[AMG88xx_STAT] |= STAT_OVF_IRS;
+      out = out > 0 ? 2047 : -2048;
+    }
+
+    uint8_t *reg = &_regs[AMG88xx_PIXEL_OFFSET + (i << 1)];
+    int16_t previous = (int16_t)((((uint16_t)reg[1] << 8) | reg[0]) << 4) >> 4;
+    reg[0] = out & 0xFF;
+    reg[1] = (out >> 8) & 0x0F;
+
+    checkInterrupt(i, out, previous);
+  }
+
+  // the thermistor is 12 bit signed magnitude
+  int16_t therm = _thermistor;
+  uint16_t mag = therm < 0 ? -therm : therm;
+  if (mag > 0x7FF) {
+    _regs[AMG88xx_STAT] |= STAT_OVF_THS;
+    mag = 0x7FF;
+  }
+  _regs[AMG88xx_TTHL] = mag & 0xFF;
+  _regs[AMG88xx_TTHH] = (mag >> 8) | (therm < 0 ? 0x08 : 0);
+
+  _frames++;
+}
+
+// compare one pixel against the interrupt levels. In absolute mode the pixel
+// value itself is compared, in difference mode its change since the last
+// frame. A pixel that triggered is re-armed once it is back inside the
+// levels by the hysteresis.
+void AMG88xx_Simulator::checkInterrupt(uint8_t i, int16_t value,
+                                       int16_t previous) {
+  int16_t v = (_regs[AMG88xx_INTC] & 0x02) ? value : value - previous;
+  int16_t high = level(AMG88xx_INTHL);
+  int16_t low = level(AMG88xx_INTLL);
+  int16_t hys = level(AMG88xx_IHYSL);
+  uint64_t bit = (uint64_t)1 << i;
+
+  if (v > high || v < low) {
+    if (_armed & bit) {
+      _regs[AMG88xx_INT_OFFSET + (i >> 3)] |= 1 << (i & 0x07);
+      _regs[AMG88xx_STAT] |= STAT_INTF;
+      _armed &= ~bit;
+    }
+  } else if (v <= high - hys && v >= low + hys) {
+    _armed |= bit;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Connect to a simulator
+    @param  sim the simulated sensor
+    @returns True if sim is not NULL
+*/
+/**************************************************************************/
+bool AMG88xx_SimulatorBus::begin(AMG88xx_Simulator *sim) {
+  _sim = sim;
+  return _sim != NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  read consecutive registers, as a pointer write and a read
+    @param  reg the first register
+    @param  buf where to place the data
+    @param  num the number of bytes to read
+    @returns True on success
+*/
+/**************************************************************************/
+bool AMG88xx_SimulatorBus::read(uint8_t reg, uint8_t *buf, uint8_t num) {
+  _sim->update(millis());
+  return _sim->write(&reg, 1) && _sim->read(buf, num);
+}
+
+/**************************************************************************/
+/*!
+    @brief  write consecutive registers in one transaction
+    @param  reg the first register
+    @param  buf the data to write
+    @param  num the number of bytes to write
+    @returns True on success
+*/
+/**************************************************************************/
+bool AMG88xx_SimulatorBus::write(uint8_t reg, const uint8_t *buf,
+                                 uint8_t num) {
+  _sim->update(millis());
+  return _sim->write(buf, num, &reg, 1);
+}
+
+/**************************************************************************/
+/*!
+    @brief  wait for the sensor
+    @param  ms the time in milliseconds
+*/
+/**************************************************************************/
+void AMG88xx_SimulatorBus::delay(uint32_t ms) { ::delay(ms); }
@@ -0,0 +1,112 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_SIMULATOR_H
+#define LIB_ADAFRUIT_AMG88XX_SIMULATOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct AMG88xx_RawFrame;
+
+/**************************************************************************/
+/*!
+    @brief  Software model of an AMG88xx for running the driver without
+   hardware. It keeps the full register map, produces frames from a scene
+   at the configured frame rate, applies the moving average, fills in the
+   interrupt table and status flags, and drives a virtual INT pin.
+
+   The bus side speaks the same register pointer protocol as the real chip:
+   the first byte written sets the register pointer, further bytes are
+   written from there and reads continue from the pointer.
+*/
+/**************************************************************************/
+class AMG88xx_Simulator {
+public:
+  AMG88xx_Simulator(uint8_t addr = 0x69);
+
+  /*! @brief the I2C address the simulator answers on @returns address */
+  uint8_t address() const { return _addr; }
+
+  // scene
+  void setScene(const int16_t *raw);
+  void setPixel(uint8_t i, int16_t raw);
+  void setThermistor(int16_t raw);
+  void setNoise(uint8_t counts, uint32_t seed = 1);
+
+  // clock
+  void update(uint32_t now);
+  void latchFrame(const AMG88xx_RawFrame &frame);
+
+  /*! @brief number of frames captured so far @returns the count */
+  uint32_t frames() const { return _frames; }
+
+  /*!
+      @brief  state of the INT output
+      @returns True while the INT pin is pulled low
+  */
+  bool interruptAsserted() const;
+
+  // register access, with the side effects of a bus access
+  void writeRegisters(uint8_t reg, const uint8_t *buf, size_t len);
+  void readRegisters(uint8_t reg, uint8_t *buf, size_t len);
+
+  // I2C transactions
+  bool write(const uint8_t *buf, size_t len, const uint8_t *prefix = NULL,
+             size_t prefixLen = 0);
+  bool read(uint8_t *buf, size_t len);
+
+  /*! @brief bus transactions served so far @returns the count */
+  uint32_t transactions() const { return _transactions; }
+  /*! @brief bytes moved over the bus so far @returns the count */
+  uint32_t bytes() const { return _bytes; }
+
+private:
+  void initialReset();
+  void flagReset();
+  void capture();
+  void checkInterrupt(uint8_t i, int16_t value, int16_t previous);
+  int16_t level(uint8_t reg) const;
+  int16_t noise();
+
+  uint8_t _regs[256];
+  int16_t _scene[64];
+  int16_t _last[64]; // last measurement, before averaging
+  int16_t _thermistor;
+  uint64_t _armed; // pixels allowed to trigger, cleared by hysteresis
+
+  uint8_t _addr;
+  uint8_t _pointer = 0;
+  uint8_t _noise = 0;
+  uint32_t _seed = 1;
+
+  bool _started = false;
+  uint32_t _lastFrame = 0;
+  uint32_t _frames = 0;
+
+  uint32_t _transactions = 0;
+  uint32_t _bytes = 0;
+};
+
+/**************************************************************************/
+/*!
+    @brief  Bus policy connecting Adafruit_AMG88xx_Driver straight to a
+   simulator, for example Adafruit_AMG88xx_Driver<AMG88xx_SimulatorBus>.
+   Each access first runs the simulator's frame clock up to millis().
+*/
+/**************************************************************************/
+class AMG88xx_SimulatorBus {
+public:
+  bool begin(AMG88xx_Simulator *sim);
+  bool read(uint8_t reg, uint8_t *buf, uint8_t num);
+  bool write(uint8_t reg, const uint8_t *buf, uint8_t num);
+  void delay(uint32_t ms);
+
+  /*! @brief largest read done in one transfer @returns the size in bytes */
+  uint8_t maxTransfer() { return 255; }
+
+  /*! @brief the simulator in use @returns the simulator */
+  AMG88xx_Simulator *simulator() { return _sim; }
+
+private:
+  AMG88xx_Simulator *_sim = NULL;
+};
+
+#endif
@@ -0,0 +1,156 @@
+#if !defined(ARDUINO)
+
+#include "Adafruit_AMG88xx_Sink.h"
+
+#include <string.h>
+
+/**************************************************************************/
+/*!
+    @brief  Create a parser
+    @param  sink where to send frames
+    @param  source the id passed on in every frame, to tell links apart
+*/
+/**************************************************************************/
+AMG88xx_StreamParser::AMG88xx_StreamParser(AMG88xx_FrameSink *sink,
+                                           uint16_t source)
+    : _sink(sink), _source(source) {
+  memset(_sensors, 0, sizeof(_sensors));
+}
+
+AMG88xx_StreamParser::~AMG88xx_StreamParser(void) {
+  for (uint16_t i = 0; i < 256; i++)
+    delete _sensors[i];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Parse the next part of the stream. Packets are decoded in
+   place, so the contents of data are overwritten.
+    @param  data the bytes, starting wherever the last call stopped
+    @param  len number of bytes
+    @returns the number of frames sent to the sink
+*/
+/**************************************************************************/
+size_t AMG88xx_StreamParser::parse(uint8_t *data, size_t len) {
+  size_t frames = 0;
+  uint8_t *p = data;
+  uint8_t *end = data + len;
+  while (p < end) {
+    uint8_t *zero = (uint8_t *)memchr(p, 0, end - p);
+    if (!zero) {
+      carry(p, end - p);
+      break;
+    }
+
+    if (_carryLen || _overflow) {
+      carry(p, zero - p);
+      if (_overflow)
+        _errors++;
+      else
+        frames += packet(_carry, _carryLen);
+      _carryLen = 0;
+      _overflow = false;
+    } else {
+      frames += packet(p, zero - p);
+    }
+    p = zero + 1;
+  }
+  return frames;
+}
+
+// keep the start of a packet that continues in the next buffer
+void AMG88xx_StreamParser::carry(const uint8_t *data, size_t len) {
+  if (_carryLen + len > sizeof(_carry)) {
+    _overflow = true;
+    return;
+  }
+  memcpy(_carry + _carryLen, data, len);
+  _carryLen += len;
+}
+
+// decode one COBS encoded packet and pass its frame on
+bool AMG88xx_StreamParser::packet(uint8_t *data, size_t len) {
+  if (!len)
+    return false;
+  if (len > AMG88xx_STREAM_MAX_PACKET + 1) {
+    _errors++;
+    return false;
+  }
+
+  uint8_t n = AMG88xx_cobsDecode(data, len);
+  if (n < AMG88xx_STREAM_HEADER_SIZE + 2) {
+    _errors++;
+    return false;
+  }
+
+  // a new id gets its slot only once its packet checks out, so noise on
+  // the link cannot fill the table
+  uint8_t id = data[1];
+  Sensor first;
+  Sensor *s = _sensors[id] ? _sensors[id] : &first;
+  uint16_t last = s->frame.sequence;
+  if (!AMG88xx_decodePacket(data, n, &s->codec, &s->frame)) {
+    _errors++;
+    return false;
+  }
+  if (s == &first)
+    s = _sensors[id] = new Sensor(first);
+
+  if (s->seen) {
+    // a jump backwards is the sender restarting
+    uint16_t gap = s->frame.sequence - last - 1;
+    if (gap && gap < 0x8000) {
+      _lost += gap;
+      if (_sink)
+        _sink->lost(_source, id, gap);
+    }
+  } else {
+    s->seen = true;
+    _sensorCount++;
+  }
+  _packets++;
+
+  if (_sink) {
+    AMG88xx_FrameView view;
+    view.source = _source;
+    view.sensor = id;
+    view.sequence = s->frame.sequence;
+    view.timestamp = 0;
+    view.raw = &s->frame.raw;
+    _sink->frame(view);
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send frames of a recording to a sink, straight from the
+   recording's memory
+    @param  reader the recording
+    @param  sink where to send frames
+    @param  source the id passed on in every frame
+    @param  from the first frame
+    @param  to the frame to stop before, past the end for all of them
+    @returns the number of frames sent
+*/
+/**************************************************************************/
+uint32_t AMG88xx_readRecording(const AMG88xx_RecordingReader &reader,
+                               AMG88xx_FrameSink *sink, uint16_t source,
+                               uint32_t from, uint32_t to) {
+  if (to > reader.frames())
+    to = reader.frames();
+
+  AMG88xx_FrameView view;
+  view.source = source;
+  view.sensor = 0;
+  for (uint32_t n = from; n < to; n++) {
+    const AMG88xx_RecordedFrame *fr = reader.frame(n);
+    view.sequence = fr->sequence;
+    view.timestamp = fr->timestamp;
+    view.raw = &fr->raw;
+    sink->frame(view);
+  }
+  return from < to ? to - from : 0;
+}
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_SINK_H
+#define LIB_ADAFRUIT_AMG88XX_SINK_H
+
+#if !defined(ARDUINO)
+
+#include "Adafruit_AMG88xx_Recording.h"
+#include "Adafruit_AMG88xx_Stream.h"
+
+/**************************************************************************/
+/*!
+    @brief  One frame handed to a sink. The frame is only borrowed: it
+   points into a recording or into the parser's slot for the sensor, and is
+   valid until the call returns.
+*/
+/**************************************************************************/
+struct AMG88xx_FrameView {
+  uint16_t source;              ///< id of the parser or recording
+  uint8_t sensor;               ///< sensor id within the source
+  uint32_t sequence;            ///< frame count of that sensor
+  uint32_t timestamp;           ///< millis() when recorded, 0 for streams
+  const AMG88xx_RawFrame *raw;  ///< the frame, as the registers held it
+};
+
+/**************************************************************************/
+/*!
+    @brief  Receives frames from AMG88xx_StreamParser and
+   AMG88xx_readRecording()
+*/
+/**************************************************************************/
+class AMG88xx_FrameSink {
+public:
+  virtual ~AMG88xx_FrameSink() {}
+
+  /*!
+      @brief  Called for every frame decoded
+      @param  view the frame
+  */
+  virtual void frame(const AMG88xx_FrameView &view) = 0;
+
+  /*!
+      @brief  Called when a gap in a sensor's sequence shows lost frames
+      @param  source id of the parser
+      @param  sensor the sensor
+      @param  count number of frames lost
+  */
+  virtual void lost(uint16_t source, uint8_t sensor, uint32_t count) {
+    (void)source;
+    (void)sensor;
+    (void)count;
+  }
+};
+
+/**************************************************************************/
+/*!
+    @brief  Parses a packet stream a buffer at a time, for receivers
+   handling many sensors. Packets are found with memchr and COBS decoded in
+   the caller's buffer; only a packet split between two buffers is copied.
+
+   Every sensor id gets a slot, allocated when it first appears, holding
+   its last frame and its codec state, so one parser serves up to 256
+   sensors on one link. Use one parser per link, each with its own source
+   id.
+*/
+/**************************************************************************/
+class AMG88xx_StreamParser {
+public:
+  AMG88xx_StreamParser(AMG88xx_FrameSink *sink, uint16_t source = 0);
+  ~AMG88xx_StreamParser(void);
+  AMG88xx_StreamParser(const AMG88xx_StreamParser &) = delete;
+  AMG88xx_StreamParser &operator=(const AMG88xx_StreamParser &) = delete;
+
+  size_t parse(uint8_t *data, size_t len);
+
+  /*! @brief number of frames decoded @returns the count */
+  uint32_t packets() const { return _packets; }
+  /*! @brief number of packets dropped as damaged @returns the count */
+  uint32_t errors() const { return _errors; }
+  /*! @brief number of frames missing from the sequences @returns the count */
+  uint32_t lost() const { return _lost; }
+  /*! @brief number of sensors seen @returns the count */
+  uint16_t sensors() const { return _sensorCount; }
+
+private:
+  struct Sensor {
+    AMG88xx_StreamFrame frame;
+    AMG88xx_FrameDecoder codec;
+    bool seen = false;
+  };
+
+  bool packet(uint8_t *data, size_t len);
+  void carry(const uint8_t *data, size_t len);
+
+  AMG88xx_FrameSink *_sink;
+  uint16_t _source;
+  Sensor *_sensors[256];
+  uint16_t _sensorCount = 0;
+
+  uint32_t _packets = 0;
+  uint32_t _errors = 0;
+  uint32_t _lost = 0;
+
+  uint8_t _carry[AMG88xx_STREAM_MAX_PACKET + 1];
+  size_t _carryLen = 0;
+  bool _overflow = false;
+};
+
+uint32_t AMG88xx_readRecording(const AMG88xx_RecordingReader &reader,
+                               AMG88xx_FrameSink *sink, uint16_t source = 0,
+                               uint32_t from = 0, uint32_t to = 0xFFFFFFFF);
+
+#endif
+
+#endif
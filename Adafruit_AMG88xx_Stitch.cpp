@@ -0,0 +1,126 @@
+#include "Adafruit_AMG88xx_Stitch.h"
+
+// distance of a tile coordinate from the nearest tile edge (0..3)
+static uint8_t edgeDistance(uint8_t pos) {
+  return min(pos, (uint8_t)(AMG88xx_PIXEL_COLS - 1 - pos));
+}
+
+// map a tile coordinate back to the sensor pixel that lands there
+static uint8_t sourcePixel(uint8_t x, uint8_t y, uint8_t rotation) {
+  uint8_t r, c;
+  switch (rotation) {
+  case AMG88xx_ROTATE_90:
+    r = AMG88xx_PIXEL_ROWS - 1 - x;
+    c = y;
+    break;
+  case AMG88xx_ROTATE_180:
+    r = AMG88xx_PIXEL_ROWS - 1 - y;
+    c = AMG88xx_PIXEL_COLS - 1 - x;
+    break;
+  case AMG88xx_ROTATE_270:
+    r = x;
+    c = AMG88xx_PIXEL_COLS - 1 - y;
+    break;
+  default:
+    r = y;
+    c = x;
+    break;
+  }
+  return r * AMG88xx_PIXEL_COLS + c;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Build the gather plan for a sensor layout. Where tiles overlap,
+   each source pixel is weighted by its distance from its own tile's edges, so
+   the blend ramps linearly across the overlap.
+    @param  tiles placement of each sensor, indexed like the frames passed to
+   stitch()
+    @param  count number of tiles (up to AMG88xx_STITCH_MAX_SENSORS)
+    @param  cols composite width in pixels
+    @param  rows composite height in pixels
+    @returns True if the layout fits in the plan, false otherwise
+*/
+/**************************************************************************/
+bool AMG88xx_Stitcher::begin(const AMG88xx_StitchTile *tiles, uint8_t count,
+                             uint8_t cols, uint8_t rows) {
+  if (count == 0 || count > AMG88xx_STITCH_MAX_SENSORS)
+    return false;
+  if ((uint16_t)cols * rows > AMG88xx_STITCH_MAX_PIXELS)
+    return false;
+
+  _cols = cols;
+  _rows = rows;
+
+  uint16_t tap = 0;
+  for (uint8_t y = 0; y < rows; y++) {
+    for (uint8_t x = 0; x < cols; x++) {
+      uint8_t weights[AMG88xx_STITCH_MAX_SENSORS];
+      uint16_t total = 0;
+      uint8_t n = 0;
+
+      for (uint8_t t = 0; t < count; t++) {
+        int16_t lx = (int16_t)x - tiles[t].col;
+        int16_t ly = (int16_t)y - tiles[t].row;
+        if (lx < 0 || lx >= AMG88xx_PIXEL_COLS || ly < 0 ||
+            ly >= AMG88xx_PIXEL_ROWS)
+          continue;
+
+        weights[n] = (edgeDistance(lx) + 1) * (edgeDistance(ly) + 1);
+        total += weights[n];
+        _src[tap + n] = (t << 6) | sourcePixel(lx, ly, tiles[t].rotation);
+        n++;
+      }
+
+      // normalize to Q7 so the weights of each composite pixel sum to 128
+      uint8_t remaining = 128;
+      for (uint8_t i = 0; i < n; i++) {
+        uint8_t q = (i == n - 1) ? remaining
+                                 : (weights[i] * 128 + total / 2) / total;
+        _weight[tap + i] = q;
+        remaining -= q;
+      }
+
+      _taps[(uint16_t)y * cols + x] = n;
+      tap += n;
+    }
+  }
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Write the composite image for one set of frames
+    @param  frames one raw frame (see Adafruit_AMG88xx::readPixelsRaw) per
+   tile, in the order the tiles were passed to begin()
+    @param  out the array to place the width() * height() composite pixels
+   in. Pixels no tile covers are set to 0.
+*/
+/**************************************************************************/
+void AMG88xx_Stitcher::stitch(const int16_t *const *frames,
+                              int16_t *out) const {
+  const uint8_t *src = _src;
+  const uint8_t *weight = _weight;
+  uint16_t pixels = (uint16_t)_cols * _rows;
+
+  for (uint16_t i = 0; i < pixels; i++) {
+    uint8_t n = _taps[i];
+
+    if (n == 1) {
+      // no overlap here, copy straight through
+      out[i] = frames[*src >> 6][*src & 0x3F];
+      src++;
+      weight++;
+      continue;
+    }
+
+    int32_t acc = 64; // round to nearest
+    for (uint8_t t = 0; t < n; t++) {
+      acc += (int32_t)frames[*src >> 6][*src & 0x3F] * *weight;
+      src++;
+      weight++;
+    }
+    out[i] = n ? (int16_t)(acc >> 7) : 0;
+  }
+}
@@ -0,0 +1,76 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_STITCH_H
+#define LIB_ADAFRUIT_AMG88XX_STITCH_H
+
+#include "Adafruit_AMG88xx.h"
+
+/*=========================================================================
+    STITCHING LIMITS
+    -----------------------------------------------------------------------*/
+#ifndef AMG88xx_STITCH_MAX_SENSORS
+#define AMG88xx_STITCH_MAX_SENSORS 4
+#endif
+
+#ifndef AMG88xx_STITCH_MAX_PIXELS
+#define AMG88xx_STITCH_MAX_PIXELS 256
+#endif
+
+// a tap packs its sensor into the top two bits of a byte
+static_assert(AMG88xx_STITCH_MAX_SENSORS <= 4,
+              "AMG88xx_STITCH_MAX_SENSORS must be at most 4");
+/*=========================================================================*/
+
+enum stitch_rotations {
+  AMG88xx_ROTATE_0 = 0x00,
+  AMG88xx_ROTATE_90 = 0x01,
+  AMG88xx_ROTATE_180 = 0x02,
+  AMG88xx_ROTATE_270 = 0x03
+};
+
+/**************************************************************************/
+/*!
+    @brief  Placement of one sensor's 8x8 frame inside the composite image.
+   Tiles may overlap; overlapping pixels are blended linearly.
+*/
+/**************************************************************************/
+struct AMG88xx_StitchTile {
+  uint8_t col;      ///< composite column of the tile's left edge
+  uint8_t row;      ///< composite row of the tile's top edge
+  uint8_t rotation; ///< clockwise rotation, one of stitch_rotations
+};
+
+/**************************************************************************/
+/*!
+    @brief  Combines raw frames from several sensors into one composite raw
+   frame. The layout is turned into a gather plan once in begin(), so
+   stitch() is a single pass over the composite pixels.
+*/
+/**************************************************************************/
+class AMG88xx_Stitcher {
+public:
+  AMG88xx_Stitcher(void){};
+
+  bool begin(const AMG88xx_StitchTile *tiles, uint8_t count, uint8_t cols,
+             uint8_t rows);
+
+  void stitch(const int16_t *const *frames, int16_t *out) const;
+
+  /*! @brief composite width in pixels @returns width */
+  uint8_t width() const { return _cols; }
+  /*! @brief composite height in pixels @returns height */
+  uint8_t height() const { return _rows; }
+
+private:
+  uint8_t _cols = 0;
+  uint8_t _rows = 0;
+
+  // number of source taps for each composite pixel
+  uint8_t _taps[AMG88xx_STITCH_MAX_PIXELS];
+
+  // taps in composite pixel order: (sensor << 6) | pixel and Q7 weight.
+  // every source pixel lands on exactly one composite pixel, so the tap list
+  // is never longer than the total number of source pixels
+  uint8_t _src[AMG88xx_STITCH_MAX_SENSORS * AMG88xx_PIXEL_ARRAY_SIZE];
+  uint8_t _weight[AMG88xx_STITCH_MAX_SENSORS * AMG88xx_PIXEL_ARRAY_SIZE];
+};
+
+#endif
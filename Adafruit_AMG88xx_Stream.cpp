@@ -0,0 +1,261 @@
+#include "Adafruit_AMG88xx_Stream.h"
+
+#include <string.h>
+
+static_assert(AMG88xx_STREAM_HEADER_SIZE + AMG88xx_CODEC_MAX_SIZE + 2 <=
+                  AMG88xx_STREAM_MAX_PACKET,
+              "a compressed frame must fit a packet");
+
+/**************************************************************************/
+/*!
+    @brief  CRC-16/CCITT-FALSE (polynomial 0x1021, MSB first)
+    @param  data the bytes
+    @param  len number of bytes
+    @param  crc the CRC so far, to continue a previous call
+    @returns the CRC
+*/
+/**************************************************************************/
+uint16_t AMG88xx_crc16(const uint8_t *data, size_t len, uint16_t crc) {
+  while (len--) {
+    crc ^= (uint16_t)*data++ << 8;
+    for (uint8_t bit = 0; bit < 8; bit++)
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Pack the 12 bit pixels of a frame, two to every three bytes
+    @param  frame the frame
+    @param  packed where to place the 96 packed bytes
+*/
+/**************************************************************************/
+void AMG88xx_packRaw12(const AMG88xx_RawFrame &frame, uint8_t *packed) {
+  const uint8_t *p = frame.pixels;
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i += 2, p += 4) {
+    *packed++ = p[0];
+    *packed++ = (p[1] & 0x0F) | (p[2] << 4);
+    *packed++ = (p[2] >> 4) | (p[3] << 4);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Unpack 96 bytes of 12 bit pixels into pixel registers
+    @param  packed the packed pixels
+    @param  frame the frame to place them in
+*/
+/**************************************************************************/
+void AMG88xx_unpackRaw12(const uint8_t *packed, AMG88xx_RawFrame *frame) {
+  uint8_t *p = frame->pixels;
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i += 2, packed += 3) {
+    *p++ = packed[0];
+    *p++ = packed[1] & 0x0F;
+    *p++ = (packed[1] >> 4) | (packed[2] << 4);
+    *p++ = packed[2] >> 4;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start a stream
+    @param  out where to send packets
+    @param  sensor the id to tag packets with, to tell sensors apart
+*/
+/**************************************************************************/
+void AMG88xx_StreamEncoder::begin(Print *out, uint8_t sensor) {
+  _out = out;
+  _sensor = sensor;
+  _sequence = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send one frame
+    @param  frame the frame as read with Adafruit_AMG88xx::readRawFrame()
+    @returns True if the whole packet was written
+*/
+/**************************************************************************/
+bool AMG88xx_StreamEncoder::write(const AMG88xx_RawFrame &frame) {
+  uint8_t packet[AMG88xx_STREAM_RAW12_SIZE];
+  packet[0] = AMG88xx_STREAM_RAW12;
+  packet[1] = _sensor;
+  packet[2] = _sequence & 0xFF;
+  packet[3] = _sequence >> 8;
+  packet[4] = frame.thermistor[0];
+  packet[5] = frame.thermistor[1];
+  AMG88xx_packRaw12(frame, packet + AMG88xx_STREAM_HEADER_SIZE);
+
+  _sequence++;
+  return writePacket(packet, sizeof(packet));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send one frame compressed
+    @param  frame the frame as read with Adafruit_AMG88xx::readRawFrame()
+    @param  codec the encoder for this sensor, keeping the previous frame
+    @returns True if the whole packet was written
+*/
+/**************************************************************************/
+bool AMG88xx_StreamEncoder::write(const AMG88xx_RawFrame &frame,
+                                  AMG88xx_FrameEncoder &codec) {
+  uint8_t packet[AMG88xx_STREAM_HEADER_SIZE + AMG88xx_CODEC_MAX_SIZE + 2];
+  packet[0] = AMG88xx_STREAM_RICE;
+  packet[1] = _sensor;
+  packet[2] = _sequence & 0xFF;
+  packet[3] = _sequence >> 8;
+  packet[4] = frame.thermistor[0];
+  packet[5] = frame.thermistor[1];
+  uint8_t len = codec.encode(frame, packet + AMG88xx_STREAM_HEADER_SIZE);
+
+  _sequence++;
+  return writePacket(packet, AMG88xx_STREAM_HEADER_SIZE + len + 2);
+}
+
+// append the CRC and send COBS encoded, without a second buffer. The last
+// two bytes of packet are filled in with the CRC.
+bool AMG88xx_StreamEncoder::writePacket(uint8_t *packet, uint8_t len) {
+  uint16_t crc = AMG88xx_crc16(packet, len - 2);
+  packet[len - 2] = crc & 0xFF;
+  packet[len - 1] = crc >> 8;
+
+  bool ok = true;
+  const uint8_t *run = packet;
+  const uint8_t *end = packet + len;
+  while (ok) {
+    const uint8_t *zero = run;
+    while (zero < end && *zero && zero - run < 254)
+      zero++;
+    uint8_t code = zero - run + 1;
+    ok = _out->write(&code, 1) == 1 &&
+         _out->write(run, code - 1) == (size_t)(code - 1);
+    if (zero == end)
+      break;
+    // a full block carries no zero
+    run = code == 0xFF ? zero : zero + 1;
+  }
+
+  uint8_t delimiter = 0;
+  return ok && _out->write(&delimiter, 1) == 1;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set the decoders for AMG88xx_STREAM_RICE packets. Without them
+   those packets are dropped as damaged.
+    @param  codecs one decoder for each sensor id, indexed by the id
+    @param  count number of decoders
+*/
+/**************************************************************************/
+void AMG88xx_StreamDecoder::setCodecs(AMG88xx_FrameDecoder *codecs,
+                                      uint16_t count) {
+  _codecs = codecs;
+  _codecCount = count;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Take the next byte of the stream
+    @param  b the byte
+    @returns True if it completed a frame, then available from frame()
+*/
+/**************************************************************************/
+bool AMG88xx_StreamDecoder::push(uint8_t b) {
+  if (b) {
+    if (_len < sizeof(_buf))
+      _buf[_len++] = b;
+    else
+      _overflow = true;
+    return false;
+  }
+
+  // end of a packet
+  uint8_t len = _len;
+  bool overflow = _overflow;
+  _len = 0;
+  _overflow = false;
+  if (!len)
+    return false;
+  if (overflow) {
+    _errors++;
+    return false;
+  }
+
+  len = AMG88xx_cobsDecode(_buf, len);
+  uint8_t sensor = len > 1 ? _buf[1] : 0;
+  AMG88xx_FrameDecoder *codec = sensor < _codecCount ? &_codecs[sensor] : NULL;
+  if (!AMG88xx_decodePacket(_buf, len, codec, &_frame)) {
+    _errors++;
+    return false;
+  }
+  _packets++;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Undo the COBS encoding of one packet, in place
+    @param  data the packet, without its 0x00 delimiter
+    @param  len its encoded size
+    @returns the decoded size, or 0 if the encoding is damaged
+*/
+/**************************************************************************/
+uint8_t AMG88xx_cobsDecode(uint8_t *data, uint8_t len) {
+  uint8_t in = 0, out = 0;
+  while (in < len) {
+    uint8_t code = data[in++];
+    if (!code || in + code - 1 > len)
+      return 0;
+    for (uint8_t i = 1; i < code; i++)
+      data[out++] = data[in++];
+    if (code != 0xFF && in < len)
+      data[out++] = 0;
+  }
+  return out;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Check and unpack one decoded packet
+    @param  packet the packet, COBS decoded
+    @param  len its size
+    @param  codec the decoder for the sensor the packet is from, needed for
+   AMG88xx_STREAM_RICE packets, or NULL
+    @param  frame where to place the frame
+    @returns True if the packet was intact and decoded
+*/
+/**************************************************************************/
+bool AMG88xx_decodePacket(const uint8_t *packet, uint8_t len,
+                          AMG88xx_FrameDecoder *codec,
+                          AMG88xx_StreamFrame *frame) {
+  if (len < AMG88xx_STREAM_HEADER_SIZE + 2)
+    return false;
+  uint16_t crc = packet[len - 2] | ((uint16_t)packet[len - 1] << 8);
+  if (AMG88xx_crc16(packet, len - 2) != crc)
+    return false;
+
+  switch (packet[0]) {
+  case AMG88xx_STREAM_RAW12:
+    if (len != AMG88xx_STREAM_RAW12_SIZE)
+      return false;
+    AMG88xx_unpackRaw12(packet + AMG88xx_STREAM_HEADER_SIZE, &frame->raw);
+    break;
+  case AMG88xx_STREAM_RICE:
+    if (!codec || !codec->decode(packet + AMG88xx_STREAM_HEADER_SIZE,
+                                 len - AMG88xx_STREAM_HEADER_SIZE - 2,
+                                 &frame->raw))
+      return false;
+    break;
+  default:
+    return false;
+  }
+
+  frame->type = packet[0];
+  frame->sensor = packet[1];
+  frame->sequence = packet[2] | ((uint16_t)packet[3] << 8);
+  frame->raw.thermistor[0] = packet[4];
+  frame->raw.thermistor[1] = packet[5];
+  return true;
+}
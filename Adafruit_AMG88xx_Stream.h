@@ -0,0 +1,124 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_STREAM_H
+#define LIB_ADAFRUIT_AMG88XX_STREAM_H
+
+#include "Adafruit_AMG88xx_Codec.h"
+
+/*=========================================================================
+    STREAM FORMAT
+    -----------------------------------------------------------------------
+    Frames are sent as packets, each COBS encoded and ended by a 0x00
+    byte, so a receiver can join the stream at any point. A packet is:
+
+      type       1 byte, one of stream_packets
+      sensor     1 byte, chosen by the sender
+      sequence   2 bytes, little endian, counting packets of this sensor
+      thermistor 2 bytes, TTHL and TTHH as read
+      pixels     AMG88xx_STREAM_RAW12: 64 12 bit values packed in 96 bytes,
+                 two pixels in three bytes, low bits first
+                 AMG88xx_STREAM_RICE: a frame from AMG88xx_FrameEncoder,
+                 one encoder per sensor
+      crc        2 bytes, CRC-16/CCITT-FALSE of everything before it
+
+    A raw frame is 106 bytes on the wire, against ~470 bytes printed as
+    text, so 10 FPS fits from 19200 baud up. A compressed frame is 45
+    bytes on average: the codec's 35 bytes for the scene measured in
+    Adafruit_AMG88xx_Codec.h, plus the header, CRC and COBS framing.
+    -----------------------------------------------------------------------*/
+enum stream_packets {
+  AMG88xx_STREAM_RAW12 = 0x01, ///< packed 12 bit pixels
+  AMG88xx_STREAM_RICE = 0x02,  ///< pixels compressed with the frame codec
+};
+
+#define AMG88xx_STREAM_HEADER_SIZE 6
+#define AMG88xx_STREAM_RAW12_SIZE (AMG88xx_STREAM_HEADER_SIZE + 96 + 2)
+#define AMG88xx_STREAM_MAX_PACKET 254 ///< largest packet before COBS
+/*=========================================================================*/
+
+uint16_t AMG88xx_crc16(const uint8_t *data, size_t len, uint16_t crc = 0xFFFF);
+void AMG88xx_packRaw12(const AMG88xx_RawFrame &frame, uint8_t *packed);
+void AMG88xx_unpackRaw12(const uint8_t *packed, AMG88xx_RawFrame *frame);
+uint8_t AMG88xx_cobsDecode(uint8_t *data, uint8_t len);
+
+/**************************************************************************/
+/*!
+    @brief  A frame received from a stream
+*/
+/**************************************************************************/
+struct AMG88xx_StreamFrame {
+  uint8_t type;         ///< one of stream_packets
+  uint8_t sensor;       ///< sensor id given by the sender
+  uint16_t sequence;    ///< packet count of that sensor
+  AMG88xx_RawFrame raw; ///< the frame, as the registers held it
+};
+
+bool AMG88xx_decodePacket(const uint8_t *packet, uint8_t len,
+                          AMG88xx_FrameDecoder *codec,
+                          AMG88xx_StreamFrame *frame);
+
+/**************************************************************************/
+/*!
+    @brief  Sends frames as COBS framed packets to any Print, for example
+   Serial. Packets are encoded on the fly, so the only buffer is the packet
+   itself.
+*/
+/**************************************************************************/
+class AMG88xx_StreamEncoder {
+public:
+  void begin(Print *out, uint8_t sensor = 0);
+  bool write(const AMG88xx_RawFrame &frame);
+  bool write(const AMG88xx_RawFrame &frame, AMG88xx_FrameEncoder &codec);
+
+  /*!
+      @brief  Read a frame from a sensor and send it
+      @param  sensor the sensor
+      @returns True if the frame was read and sent
+  */
+  template <class Bus> bool send(Adafruit_AMG88xx_Driver<Bus> &sensor) {
+    AMG88xx_RawFrame raw;
+    return sensor.readRawFrame(&raw) && write(raw);
+  }
+
+  /*! @brief number of packets sent @returns the count */
+  uint16_t sequence() const { return _sequence; }
+
+private:
+  bool writePacket(uint8_t *packet, uint8_t len);
+
+  Print *_out = NULL;
+  uint8_t _sensor = 0;
+  uint16_t _sequence = 0;
+};
+
+/**************************************************************************/
+/*!
+    @brief  Turns a byte stream back into frames. Feed it bytes as they
+   arrive; damaged packets are dropped and counted, and decoding picks up
+   again at the next packet.
+*/
+/**************************************************************************/
+class AMG88xx_StreamDecoder {
+public:
+  void setCodecs(AMG88xx_FrameDecoder *codecs, uint16_t count);
+  bool push(uint8_t b);
+
+  /*! @brief the last frame decoded @returns the frame */
+  const AMG88xx_StreamFrame &frame() const { return _frame; }
+
+  /*! @brief number of frames decoded @returns the count */
+  uint32_t packets() const { return _packets; }
+  /*! @brief number of packets dropped as damaged @returns the count */
+  uint32_t errors() const { return _errors; }
+
+private:
+  AMG88xx_StreamFrame _frame;
+  AMG88xx_FrameDecoder *_codecs = NULL;
+  uint16_t _codecCount = 0;
+  uint32_t _packets = 0;
+  uint32_t _errors = 0;
+
+  uint8_t _buf[AMG88xx_STREAM_MAX_PACKET + 1];
+  uint8_t _len = 0;
+  bool _overflow = false;
+};
+
+#endif
@@ -0,0 +1,209 @@
+#include "Adafruit_AMG88xx_Tracker.h"
+
+// which side of the line a point is on: > 0 right, < 0 left, 0 on the line
+static int32_t side(const AMG88xx_Line &l, int32_t x, int32_t y) {
+  int64_t cross = (int64_t)(l.x1 - l.x0) * (y - l.y0) -
+                  (int64_t)(l.y1 - l.y0) * (x - l.x0);
+  return (cross > 0) - (cross < 0);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Create a tracker
+    @param  gate the furthest a track may move between frames and still be
+   matched, in 1/256 pixels. Default is 2 pixels.
+    @param  maxMissed frames a track survives without a match before its
+   slot is freed. Default is 3.
+*/
+/**************************************************************************/
+AMG88xx_Tracker::AMG88xx_Tracker(uint16_t gate, uint8_t maxMissed)
+    : _gateSq((uint32_t)gate * gate), _maxMissed(maxMissed) {
+  clear();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Add a counting line
+    @param  x0 first point column, in 1/256 pixels
+    @param  y0 first point row, in 1/256 pixels
+    @param  x1 second point column, in 1/256 pixels
+    @param  y1 second point row, in 1/256 pixels
+    @returns the line index, or -1 if AMG88xx_MAX_LINES are already set
+*/
+/**************************************************************************/
+int8_t AMG88xx_Tracker::addLine(int16_t x0, int16_t y0, int16_t x1,
+                                int16_t y1) {
+  if (_lineCount >= AMG88xx_MAX_LINES)
+    return -1;
+
+  AMG88xx_Line &l = _lines[_lineCount];
+  l.x0 = x0;
+  l.y0 = y0;
+  l.x1 = x1;
+  l.y1 = y1;
+  l.in = 0;
+  l.out = 0;
+  return _lineCount++;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Zero the in and out counts of every line
+*/
+/**************************************************************************/
+void AMG88xx_Tracker::resetCounts() {
+  for (uint8_t i = 0; i < _lineCount; i++) {
+    _lines[i].in = 0;
+    _lines[i].out = 0;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Drop every track
+*/
+/**************************************************************************/
+void AMG88xx_Tracker::clear() {
+  for (uint8_t t = 0; t < AMG88xx_MAX_TRACKS; t++)
+    _tracks[t].id = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Match one frame's blobs to the tracks, start tracks for new blobs
+   and count line crossings
+    @param  blobs the blobs found in the frame
+    @param  count the number of blobs
+*/
+/**************************************************************************/
+void AMG88xx_Tracker::update(const AMG88xx_Blob *blobs, uint8_t count) {
+  count = min(count, (uint8_t)AMG88xx_MAX_BLOBS);
+
+  // bit t / b set once track t / blob b has been matched
+  uint16_t trackUsed = 0;
+  uint16_t blobUsed = 0;
+
+  // greedy: repeatedly take the closest unmatched pair inside the gate
+  while (true) {
+    uint32_t best = _gateSq + 1;
+    uint8_t bestTrack = 0, bestBlob = 0;
+
+    for (uint8_t t = 0; t < AMG88xx_MAX_TRACKS; t++) {
+      if (!_tracks[t].id || (trackUsed & (1 << t)))
+        continue;
+      for (uint8_t b = 0; b < count; b++) {
+        if (blobUsed & (1 << b))
+          continue;
+        int32_t dx = (int32_t)blobs[b].x - _tracks[t].x;
+        int32_t dy = (int32_t)blobs[b].y - _tracks[t].y;
+        uint32_t d = (uint32_t)(dx * dx) + (uint32_t)(dy * dy);
+        if (d < best) {
+          best = d;
+          bestTrack = t;
+          bestBlob = b;
+        }
+      }
+    }
+
+    if (best > _gateSq)
+      break;
+
+    AMG88xx_Track &track = _tracks[bestTrack];
+    track.prevX = track.x;
+    track.prevY = track.y;
+    track.x = blobs[bestBlob].x;
+    track.y = blobs[bestBlob].y;
+    track.missed = 0;
+    if (track.age < 255)
+      track.age++;
+    trackUsed |= 1 << bestTrack;
+    blobUsed |= 1 << bestBlob;
+
+    countCrossings(track);
+  }
+
+  // age out tracks that found nothing
+  for (uint8_t t = 0; t < AMG88xx_MAX_TRACKS; t++) {
+    if (!_tracks[t].id || (trackUsed & (1 << t)))
+      continue;
+    if (++_tracks[t].missed > _maxMissed)
+      _tracks[t].id = 0;
+  }
+
+  // start tracks for the blobs that are left, while slots last
+  uint8_t t = 0;
+  for (uint8_t b = 0; b < count; b++) {
+    if (blobUsed & (1 << b))
+      continue;
+    while (t < AMG88xx_MAX_TRACKS && _tracks[t].id)
+      t++;
+    if (t == AMG88xx_MAX_TRACKS)
+      break;
+
+    // ids wrap, so skip those still held by a long lived track
+    uint8_t id;
+    do {
+      id = _nextId;
+      _nextId = _nextId == 255 ? 1 : _nextId + 1;
+    } while (idInUse(id));
+
+    AMG88xx_Track &track = _tracks[t];
+    track.id = id;
+    track.age = 1;
+    track.missed = 0;
+    track.x = track.prevX = blobs[b].x;
+    track.y = track.prevY = blobs[b].y;
+    track.sided = 0;
+    track.right = 0;
+    countCrossings(track);
+  }
+}
+
+// whether a live track holds the id
+bool AMG88xx_Tracker::idInUse(uint8_t id) const {
+  for (uint8_t t = 0; t < AMG88xx_MAX_TRACKS; t++) {
+    if (_tracks[t].id == id)
+      return true;
+  }
+  return false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Count the crossings made by a track's last step. A track has to
+   come off the line on the other side to count, so stopping on a line or
+   touching it and turning back is not a crossing.
+    @param  track the track, just matched
+*/
+/**************************************************************************/
+void AMG88xx_Tracker::countCrossings(AMG88xx_Track &track) {
+  for (uint8_t i = 0; i < _lineCount; i++) {
+    AMG88xx_Line &l = _lines[i];
+    uint8_t bit = 1 << i;
+    int32_t to = side(l, track.x, track.y);
+    if (to == 0)
+      continue;
+
+    bool wasSided = track.sided & bit;
+    bool wasRight = track.right & bit;
+    track.sided |= bit;
+    if (to > 0)
+      track.right |= bit;
+    else
+      track.right &= ~bit;
+
+    if (!wasSided || wasRight == (to > 0))
+      continue;
+
+    // the step must also pass between the line's end points
+    AMG88xx_Line step = {(int16_t)track.prevX, (int16_t)track.prevY,
+                         (int16_t)track.x,     (int16_t)track.y, 0, 0};
+    if (side(step, l.x0, l.y0) * side(step, l.x1, l.y1) > 0)
+      continue;
+
+    if (to > 0)
+      l.in++;
+    else
+      l.out++;
+  }
+}
@@ -0,0 +1,107 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_TRACKER_H
+#define LIB_ADAFRUIT_AMG88XX_TRACKER_H
+
+#include "Adafruit_AMG88xx_Blobs.h"
+
+#ifndef AMG88xx_MAX_TRACKS
+#define AMG88xx_MAX_TRACKS 8
+#endif
+
+// at most 8, line state is kept in a byte per track
+#ifndef AMG88xx_MAX_LINES
+#define AMG88xx_MAX_LINES 4
+#endif
+
+// update() marks matched tracks and blobs in 16 bit masks
+static_assert(AMG88xx_MAX_TRACKS <= 16,
+              "AMG88xx_MAX_TRACKS must be at most 16");
+static_assert(AMG88xx_MAX_BLOBS <= 16, "AMG88xx_MAX_BLOBS must be at most 16");
+static_assert(AMG88xx_MAX_LINES <= 8, "AMG88xx_MAX_LINES must be at most 8");
+
+/**************************************************************************/
+/*!
+    @brief  An object followed from frame to frame. Positions are in 1/256
+   pixels like AMG88xx_Blob.
+*/
+/**************************************************************************/
+struct AMG88xx_Track {
+  uint8_t id;     ///< track id, 0 if the slot is free
+  uint8_t age;    ///< frames the track has been matched, saturates at 255
+  uint8_t missed; ///< consecutive frames without a match
+  uint16_t x;     ///< current column
+  uint16_t y;     ///< current row
+  uint16_t prevX; ///< column on the previous match
+  uint16_t prevY; ///< row on the previous match
+  uint8_t sided;  ///< bit n set once the track has been off line n
+  uint8_t right;  ///< bit n set if the track was last right of line n
+};
+
+/**************************************************************************/
+/*!
+    @brief  A virtual counting line. Tracks crossing from the left of the
+   line (looking from the first point to the second) to its right count as
+   in, the other way as out.
+*/
+/**************************************************************************/
+struct AMG88xx_Line {
+  int16_t x0;   ///< first point column, in 1/256 pixels
+  int16_t y0;   ///< first point row, in 1/256 pixels
+  int16_t x1;   ///< second point column, in 1/256 pixels
+  int16_t y1;   ///< second point row, in 1/256 pixels
+  uint16_t in;  ///< crossings to the right of the line
+  uint16_t out; ///< crossings to the left of the line
+};
+
+/**************************************************************************/
+/*!
+    @brief  Associates blobs with a fixed table of tracks by greedy nearest
+   neighbour matching and counts crossings of virtual lines. Memory is fixed
+   and the work per frame is bounded by AMG88xx_MAX_TRACKS and
+   AMG88xx_MAX_BLOBS.
+*/
+/**************************************************************************/
+class AMG88xx_Tracker {
+public:
+  AMG88xx_Tracker(uint16_t gate = 2 << 8, uint8_t maxMissed = 3);
+
+  int8_t addLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+  void resetCounts();
+  void clear();
+
+  void update(const AMG88xx_Blob *blobs, uint8_t count);
+
+  /*!
+      @brief  associate the blobs from a blob finder
+      @param  blobs the blob finder, after find()
+  */
+  void update(const AMG88xx_BlobFinder &blobs) {
+    update(&blobs.blob(0), blobs.count());
+  }
+
+  /*!
+      @brief  a counting line
+      @param  i the value returned by addLine()
+      @returns the line and its counts
+  */
+  const AMG88xx_Line &line(uint8_t i) const { return _lines[i]; }
+
+  /*!
+      @brief  a slot in the track table, check id for whether it is in use
+      @param  i the slot, less than AMG88xx_MAX_TRACKS
+      @returns the track
+  */
+  const AMG88xx_Track &track(uint8_t i) const { return _tracks[i]; }
+
+private:
+  bool idInUse(uint8_t id) const;
+  void countCrossings(AMG88xx_Track &track);
+
+  AMG88xx_Track _tracks[AMG88xx_MAX_TRACKS];
+  AMG88xx_Line _lines[AMG88xx_MAX_LINES];
+  uint8_t _lineCount = 0;
+  uint8_t _nextId = 1;
+  uint32_t _gateSq;
+  uint8_t _maxMissed;
+};
+
+#endif
@@ -0,0 +1,67 @@
+#include "Adafruit_AMG88xx_Zones.h"
+
+/**************************************************************************/
+/*!
+    @brief  Add a zone
+    @param  mask the pixels in the zone, must not be empty
+    @returns the zone index, or -1 if the mask is empty or
+   AMG88xx_MAX_ZONES are already set
+*/
+/**************************************************************************/
+int8_t AMG88xx_Zones::addZone(uint64_t mask) {
+  if (!mask || _count >= AMG88xx_MAX_ZONES)
+    return -1;
+
+  _masks[_count] = mask;
+  _results[_count].area = AMG88xx_maskCount(mask);
+  for (uint64_t m = mask; m; m &= m - 1)
+    _membership[AMG88xx_maskFirst(m)] |= 1 << _count;
+
+  return _count++;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Remove every zone
+*/
+/**************************************************************************/
+void AMG88xx_Zones::clear() {
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++)
+    _membership[i] = 0;
+  _count = 0;
+  _over = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Compute every zone's aggregates for a frame
+    @param  raw a raw frame from Adafruit_AMG88xx::readPixelsRaw
+    @param  threshold pixels above this many raw counts are counted
+*/
+/**************************************************************************/
+void AMG88xx_Zones::evaluate(const int16_t *raw, int16_t threshold) {
+  for (uint8_t z = 0; z < _count; z++) {
+    _results[z].sum = 0;
+    _results[z].maxValue = -0x8000;
+  }
+
+  uint64_t over = 0;
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++) {
+    int16_t v = raw[i];
+    if (v > threshold)
+      over |= (uint64_t)1 << i;
+
+    for (uint16_t m = _membership[i]; m; m &= m - 1) {
+      AMG88xx_ZoneResult &r = _results[__builtin_ctz(m)];
+      r.sum += v;
+      if (v > r.maxValue)
+        r.maxValue = v;
+    }
+  }
+
+  for (uint8_t z = 0; z < _count; z++) {
+    _results[z].mean = _results[z].sum / _results[z].area;
+    _results[z].count = AMG88xx_maskCount(_masks[z] & over);
+  }
+  _over = over;
+}
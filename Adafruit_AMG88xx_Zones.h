@@ -0,0 +1,66 @@
+#ifndef LIB_ADAFRUIT_AMG88XX_ZONES_H
+#define LIB_ADAFRUIT_AMG88XX_ZONES_H
+
+#include "Adafruit_AMG88xx.h"
+#include "Adafruit_AMG88xx_Bitboard.h"
+
+// at most 16, zone membership is kept in a uint16_t per pixel
+#ifndef AMG88xx_MAX_ZONES
+#define AMG88xx_MAX_ZONES 16
+#endif
+
+/**************************************************************************/
+/*!
+    @brief  Aggregates of one zone for one frame, in raw counts
+*/
+/**************************************************************************/
+struct AMG88xx_ZoneResult {
+  int32_t sum;      ///< sum of the zone's pixels
+  int16_t mean;     ///< mean of the zone's pixels
+  int16_t maxValue; ///< hottest pixel in the zone
+  uint8_t area;     ///< number of pixels in the zone
+  uint8_t count;    ///< number of the zone's pixels over the threshold
+};
+
+/**************************************************************************/
+/*!
+    @brief  Per-zone mean, max and over-threshold count for up to
+   AMG88xx_MAX_ZONES regions of interest, each given as a pixel mask (see
+   Adafruit_AMG88xx_Bitboard.h). The frame is walked once no matter how many
+   zones there are.
+*/
+/**************************************************************************/
+class AMG88xx_Zones {
+public:
+  AMG88xx_Zones(void) { clear(); }
+
+  int8_t addZone(uint64_t mask);
+  void clear();
+
+  void evaluate(const int16_t *raw, int16_t threshold);
+
+  /*! @brief number of zones added @returns the count */
+  uint8_t count() const { return _count; }
+
+  /*!
+      @brief  the results of the last evaluate() for one zone
+      @param  zone the value returned by addZone()
+      @returns the zone's aggregates
+  */
+  const AMG88xx_ZoneResult &result(uint8_t zone) const {
+    return _results[zone];
+  }
+
+  /*! @brief pixels over the threshold in the last evaluate() @returns mask */
+  uint64_t overThreshold() const { return _over; }
+
+private:
+  uint64_t _masks[AMG88xx_MAX_ZONES];
+  // bit z set for every zone z containing the pixel
+  uint16_t _membership[AMG88xx_PIXEL_ARRAY_SIZE];
+  AMG88xx_ZoneResult _results[AMG88xx_MAX_ZONES];
+  uint64_t _over = 0;
+  uint8_t _count = 0;
+};
+
+#endif
@@ -0,0 +1,52 @@
+/***************************************************************************
+  This is a library for the AMG88xx GridEYE 8x8 IR camera
+
+  This sketch streams a binary recording of every frame over the serial
+  port, 140 bytes a frame instead of the ~800 bytes pixels_test prints.
+  Capture it on the computer, for example with
+
+    stty -F /dev/ttyACM0 115200 raw && cat /dev/ttyACM0 > capture.amg
+
+  and read it back with AMG88xx_RecordingReader or
+  extras/tools/amg88xx_dump.cpp.
+
+  Designed specifically to work with the Adafruit AMG88 breakout
+  ----> http://www.adafruit.com/products/3538
+
+  These sensors use I2C to communicate. The device's I2C address is 0x69
+
+  Adafruit invests time and resources providing this open source code,
+  please support Adafruit andopen-source hardware by purchasing products
+  from Adafruit!
+
+  BSD license, all text above must be included in any redistribution
+ ***************************************************************************/
+
+#include <Wire.h>
+#include <Adafruit_AMG88xx.h>
+#include <Adafruit_AMG88xx_Recording.h>
+
+Adafruit_AMG88xx amg;
+AMG88xx_RecordingWriter recording;
+AMG88xx_Profile profile;
+
+void setup() {
+  Serial.begin(115200);
+
+  if (!amg.begin()) {
+    while (1);
+  }
+  amg.apply(profile);
+
+  recording.begin(&Serial, profile);
+}
+
+void loop() {
+  // a new frame every 100 ms at 10 FPS
+  static uint32_t next = millis();
+  if ((int32_t)(millis() - next) < 0)
+    return;
+  next += 100;
+
+  recording.record(amg);
+}
@@ -0,0 +1,71 @@
+/***************************************************************************
+  This is a library for the AMG88xx GridEYE 8x8 IR camera
+
+  This sketch stitches two sensors mounted side by side into one 14x8
+  frame. The sensors share two columns of their field of view, which are
+  blended together.
+
+  Designed specifically to work with the Adafruit AMG88 breakout
+  ----> http://www.adafruit.com/products/3538
+
+  These sensors use I2C to communicate. One sensor stays on the default
+  address 0x69, the other is jumpered to 0x68.
+
+  Adafruit invests time and resources providing this open source code,
+  please support Adafruit andopen-source hardware by purchasing products
+  from Adafruit!
+
+  BSD license, all text above must be included in any redistribution
+ ***************************************************************************/
+
+#include <Wire.h>
+#include <Adafruit_AMG88xx.h>
+#include <Adafruit_AMG88xx_Stitch.h>
+
+#define OVERLAP 2
+#define COMPOSITE_COLS (2 * AMG88xx_PIXEL_COLS - OVERLAP)
+#define COMPOSITE_ROWS AMG88xx_PIXEL_ROWS
+
+Adafruit_AMG88xx left, right;
+AMG88xx_Stitcher stitcher;
+
+// left sensor at column 0, right sensor starts OVERLAP columns early
+const AMG88xx_StitchTile layout[] = {
+  {0, 0, AMG88xx_ROTATE_0},
+  {AMG88xx_PIXEL_COLS - OVERLAP, 0, AMG88xx_ROTATE_0},
+};
+
+int16_t leftPixels[AMG88xx_PIXEL_ARRAY_SIZE];
+int16_t rightPixels[AMG88xx_PIXEL_ARRAY_SIZE];
+int16_t composite[COMPOSITE_COLS * COMPOSITE_ROWS];
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println(F("AMG88xx stitching"));
+
+  if (!left.begin(0x69) || !right.begin(0x68)) {
+    Serial.println("Could not find both AMG88xx sensors, check wiring!");
+    while (1);
+  }
+
+  stitcher.begin(layout, 2, COMPOSITE_COLS, COMPOSITE_ROWS);
+}
+
+void loop() {
+  left.readPixelsRaw(leftPixels);
+  right.readPixelsRaw(rightPixels);
+
+  const int16_t *frames[] = {leftPixels, rightPixels};
+  stitcher.stitch(frames, composite);
+
+  for (int y = 0; y < COMPOSITE_ROWS; y++) {
+    for (int x = 0; x < COMPOSITE_COLS; x++) {
+      Serial.print(composite[y * COMPOSITE_COLS + x] * AMG88xx_PIXEL_TEMP_CONVERSION);
+      Serial.print(", ");
+    }
+    Serial.println();
+  }
+  Serial.println();
+
+  delay(1000);
+}
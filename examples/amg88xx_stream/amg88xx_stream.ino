@@ -0,0 +1,48 @@
+/***************************************************************************
+  This is a library for the AMG88xx GridEYE 8x8 IR camera
+
+  This sketch streams every frame over the serial port as compact binary
+  packets, 106 bytes a frame with a sequence number and CRC, so the full
+  10 FPS fits down to 19200 baud. Decode it on the computer with
+  AMG88xx_StreamDecoder, or
+
+    stty -F /dev/ttyACM0 19200 raw && amg88xx_dump --stream /dev/ttyACM0
+
+  Designed specifically to work with the Adafruit AMG88 breakout
+  ----> http://www.adafruit.com/products/3538
+
+  These sensors use I2C to communicate. The device's I2C address is 0x69
+
+  Adafruit invests time and resources providing this open source code,
+  please support Adafruit andopen-source hardware by purchasing products
+  from Adafruit!
+
+  BSD license, all text above must be included in any redistribution
+ ***************************************************************************/
+
+#include <Wire.h>
+#include <Adafruit_AMG88xx.h>
+#include <Adafruit_AMG88xx_Stream.h>
+
+Adafruit_AMG88xx amg;
+AMG88xx_StreamEncoder stream;
+
+void setup() {
+  Serial.begin(19200);
+
+  if (!amg.begin()) {
+    while (1);
+  }
+
+  stream.begin(&Serial);
+}
+
+void loop() {
+  // a new frame every 100 ms at 10 FPS
+  static uint32_t next = millis();
+  if ((int32_t)(millis() - next) < 0)
+    return;
+  next += 100;
+
+  stream.send(amg);
+}
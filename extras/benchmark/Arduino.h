@@ -0,0 +1,4 @@
+// Host stand-in for Arduino.h, so example code such as
+// examples/thermal_cam_interpolate/interpolation.cpp builds into the
+// benchmark unchanged.
+#include "Adafruit_AMG88xx.h"
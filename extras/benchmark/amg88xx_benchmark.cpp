@@ -0,0 +1,315 @@
+/***************************************************************************
+  Host benchmark of the acquisition to display pipeline.
+
+  Every stage runs a fixed number of iterations over a set of simulated
+  frames with a person walking across a noisy background:
+
+    bus        register reads from the simulator, through BusIO with its
+               32 byte chunks and through the direct simulator bus
+    decode     raw register bytes to counts and to degrees C
+    filters    background model, motion, blobs, peak and zones
+    upsample   the bicubic interpolation of thermal_cam_interpolate
+    colormap   temperatures to RGB565 through a 256 entry palette
+    render     a 240x240 RGB565 frame buffer filled with 30x30 boxes
+
+  For each stage it reports the time per frame, heap allocations per
+  frame and bytes moved per frame. Only the bus stages measure their bytes,
+  as traffic counted by the simulator. For the others the figure is
+  nominal: the size of the data the stage reads plus writes, taken from its
+  buffers. The table marks nominal figures with n, and the JSON output
+  gives them as nominal_bytes_per_frame instead of bytes_per_frame.
+
+    g++ -O2 -I. -I../.. -o amg88xx_benchmark amg88xx_benchmark.cpp \
+        ../../Adafruit_AMG88xx*.cpp
+    ./amg88xx_benchmark [-n iterations] [--json]
+
+  --json prints one JSON object, for keeping track of results across
+  commits.
+ ***************************************************************************/
+
+#include "Adafruit_AMG88xx.h"
+#include "Adafruit_AMG88xx_Background.h"
+#include "Adafruit_AMG88xx_Blobs.h"
+#include "Adafruit_AMG88xx_Motion.h"
+#include "Adafruit_AMG88xx_Peak.h"
+#include "Adafruit_AMG88xx_Simulator.h"
+#include "Adafruit_AMG88xx_Zones.h"
+
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../examples/thermal_cam_interpolate/interpolation.cpp"
+
+#define FRAMES 64
+#define UPSAMPLED 24
+#define SCREEN 240
+#define BOX (SCREEN / AMG88xx_PIXEL_COLS)
+
+// every heap allocation, to prove the pipeline does none per frame
+static unsigned long allocations = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  void *p = malloc(size ? size : 1);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+static AMG88xx_Simulator sim;
+static Adafruit_AMG88xx amg;
+static Adafruit_AMG88xx_Driver<AMG88xx_SimulatorBus> direct;
+
+static AMG88xx_RawFrame rawFrames[FRAMES];
+static int16_t frames[FRAMES][AMG88xx_PIXEL_ARRAY_SIZE];
+
+static AMG88xx_Background background;
+static AMG88xx_Motion motion;
+static AMG88xx_BlobFinder blobs;
+static AMG88xx_PeakTracker peak;
+static AMG88xx_Zones zones;
+
+static AMG88xx_RawFrame raw;
+static int16_t counts[AMG88xx_PIXEL_ARRAY_SIZE];
+static float pixels[AMG88xx_PIXEL_ARRAY_SIZE];
+static float upsampled[UPSAMPLED * UPSAMPLED];
+static uint16_t palette[256];
+static uint16_t colors[AMG88xx_PIXEL_ARRAY_SIZE];
+static uint16_t screen[SCREEN * SCREEN];
+static volatile uint32_t sink;
+
+/**************************************************************************/
+/*!
+    @brief  One benchmarked stage
+*/
+/**************************************************************************/
+struct Stage {
+  const char *name;      ///< reported name
+  void (*run)(uint32_t); ///< one iteration, given the iteration number
+  uint32_t bytes;        ///< nominal bytes per frame, 0 to count bus traffic
+};
+
+/**************************************************************************/
+/*!
+    @brief  What one stage cost per frame
+*/
+/**************************************************************************/
+struct Result {
+  double ns;           ///< time
+  double allocs;       ///< heap allocations
+  double moved;        ///< bytes moved
+  double transactions; ///< bus transactions
+};
+
+static void busRaw(uint32_t) { amg.readRawFrame(&raw); }
+static void busPixels(uint32_t) { amg.readPixels(pixels); }
+static void busDirect(uint32_t) { direct.readRawFrame(&raw); }
+
+static void decodeRaw(uint32_t n) {
+  const AMG88xx_RawFrame &f = rawFrames[n % FRAMES];
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++)
+    counts[i] = f.pixel(i);
+  sink = counts[n % AMG88xx_PIXEL_ARRAY_SIZE];
+}
+
+static void decodeFloat(uint32_t n) {
+  const AMG88xx_RawFrame &f = rawFrames[n % FRAMES];
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++)
+    pixels[i] = f.pixel(i) * AMG88xx_PIXEL_TEMP_CONVERSION;
+  sink = (uint32_t)pixels[n % AMG88xx_PIXEL_ARRAY_SIZE];
+}
+
+static void filterBackground(uint32_t n) {
+  sink = (uint32_t)background.update(frames[n % FRAMES]);
+}
+
+static void filterMotion(uint32_t n) {
+  sink = (uint32_t)motion.update(frames[n % FRAMES]);
+}
+
+static void filterBlobs(uint32_t n) {
+  const int16_t *f = frames[n % FRAMES];
+  uint64_t hot = 0;
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++)
+    if (f[i] > 100)
+      hot |= (uint64_t)1 << i;
+  sink = blobs.find(hot, f);
+}
+
+static void filterPeak(uint32_t n) {
+  sink = peak.update(frames[n % FRAMES]).index;
+}
+
+static void filterZones(uint32_t n) {
+  zones.evaluate(frames[n % FRAMES], 100);
+  sink = (uint32_t)zones.overThreshold();
+}
+
+static void upsample(uint32_t n) {
+  const int16_t *f = frames[n % FRAMES];
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++)
+    pixels[i] = f[i] * AMG88xx_PIXEL_TEMP_CONVERSION;
+  interpolate_image(pixels, AMG88xx_PIXEL_ROWS, AMG88xx_PIXEL_COLS, upsampled,
+                    UPSAMPLED, UPSAMPLED);
+}
+
+static void colormap(uint32_t n) {
+  const int16_t *f = frames[n % FRAMES];
+  // 16 to 40 degrees C across the palette
+  for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++) {
+    int32_t index = (f[i] - 64) * 256 / 96;
+    colors[i] = palette[constrain(index, (int32_t)0, (int32_t)255)];
+  }
+}
+
+static void render(uint32_t n) {
+  colors[0] = (uint16_t)n;
+  for (uint8_t y = 0; y < AMG88xx_PIXEL_ROWS; y++) {
+    for (uint8_t x = 0; x < AMG88xx_PIXEL_COLS; x++) {
+      uint16_t c = colors[y * AMG88xx_PIXEL_COLS + x];
+      for (uint16_t row = 0; row < BOX; row++) {
+        uint16_t *p = &screen[(y * BOX + row) * SCREEN + x * BOX];
+        for (uint16_t col = 0; col < BOX; col++)
+          p[col] = c;
+      }
+    }
+  }
+  sink = screen[n % (SCREEN * SCREEN)];
+}
+
+static Stage stages[] = {
+    {"bus.busio_raw_frame", busRaw, 0},
+    {"bus.busio_read_pixels", busPixels, 0},
+    {"bus.direct_raw_frame", busDirect, 0},
+    {"decode.counts", decodeRaw, 128 + 128},
+    {"decode.float", decodeFloat, 128 + 256},
+    {"filter.background", filterBackground, 128 + 64 * 6},
+    {"filter.motion", filterMotion, 128 + 128},
+    {"filter.blobs", filterBlobs, 128},
+    {"filter.peak", filterPeak, 128},
+    {"filter.zones", filterZones, 128},
+    {"upsample.bicubic", upsample, 128 + 256 + UPSAMPLED * UPSAMPLED * 4},
+    {"colormap.rgb565", colormap, 128 + 128},
+    {"render.boxes", render, 128 + SCREEN * SCREEN * 2},
+};
+
+#define STAGES (sizeof(stages) / sizeof(stages[0]))
+
+// a warm room with a person walking across, captured through the simulator
+static void buildScene() {
+  sim.setNoise(2, 12345);
+  for (uint8_t n = 0; n < FRAMES; n++) {
+    for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++)
+      sim.setPixel(i, 88);
+    uint8_t col = (n / 4) % AMG88xx_PIXEL_COLS;
+    for (uint8_t row = 2; row < 7; row++)
+      sim.setPixel(row * AMG88xx_PIXEL_COLS + col, 136);
+    delay(100);
+    amg.readRawFrame(&rawFrames[n]);
+    for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++)
+      frames[n][i] = rawFrames[n].pixel(i);
+  }
+
+  for (uint16_t i = 0; i < 256; i++) {
+    // blue to red through green
+    uint8_t r = i > 128 ? (i - 128) >> 2 : 0;
+    uint8_t g = (i < 128 ? i : 255 - i) >> 1;
+    uint8_t b = i < 128 ? (127 - i) >> 2 : 0;
+    palette[i] = (r << 11) | (g << 5) | b;
+  }
+
+  zones.addZone(0x00000000000000FFULL);
+  zones.addZone(0x0000001818000000ULL);
+  zones.addZone(0xFF00000000000000ULL);
+}
+
+static Result measure(const Stage &s, uint32_t iterations) {
+  // warm up caches and branch predictors
+  for (uint32_t i = 0; i < iterations / 10 + 1; i++)
+    s.run(i);
+
+  unsigned long allocs = allocations;
+  uint32_t bytes = sim.bytes();
+  uint32_t transactions = sim.transactions();
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; i++)
+    s.run(i);
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+  Result r;
+  r.ns = std::chrono::duration<double, std::nano>(end - start).count() /
+         iterations;
+  r.allocs = (double)(allocations - allocs) / iterations;
+  r.transactions = (double)(sim.transactions() - transactions) / iterations;
+  r.moved = s.bytes ? s.bytes : (double)(sim.bytes() - bytes) / iterations;
+  return r;
+}
+
+int main(int argc, char **argv) {
+  uint32_t iterations = 2000;
+  bool json = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--json"))
+      json = true;
+    else if (!strcmp(argv[i], "-n") && i + 1 < argc)
+      iterations = strtoul(argv[++i], NULL, 0);
+    else {
+      fprintf(stderr, "usage: %s [-n iterations] [--json]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (!iterations)
+    iterations = 1;
+
+  // frames only advance when the benchmark says so
+  AMG88xx_useVirtualClock(true);
+  Wire.attach(&sim);
+  if (!amg.begin() || !direct.begin(&sim)) {
+    fprintf(stderr, "simulated sensor did not start\n");
+    return 1;
+  }
+  buildScene();
+
+  Result results[STAGES];
+  double total = 0;
+  for (uint8_t i = 0; i < STAGES; i++) {
+    results[i] = measure(stages[i], iterations);
+    total += results[i].ns;
+  }
+
+  if (json) {
+    printf("{\"iterations\": %u, \"stages\": [", (unsigned)iterations);
+    for (uint8_t i = 0; i < STAGES; i++) {
+      printf("%s\n  {\"name\": \"%s\", \"ns_per_frame\": %.1f, "
+             "\"allocs_per_frame\": %.2f, \"%sbytes_per_frame\": %.1f, "
+             "\"bus_transactions_per_frame\": %.2f}",
+             i ? "," : "", stages[i].name, results[i].ns, results[i].allocs,
+             stages[i].bytes ? "nominal_" : "", results[i].moved,
+             results[i].transactions);
+    }
+    printf("\n]}\n");
+  } else {
+    printf("%-24s %12s %8s %11s %6s\n", "stage", "ns/frame", "allocs",
+           "bytes", "xfers");
+    for (uint8_t i = 0; i < STAGES; i++) {
+      printf("%-24s %12.1f %8.2f %10.1f%c %6.2f\n", stages[i].name,
+             results[i].ns, results[i].allocs, results[i].moved,
+             stages[i].bytes ? 'n' : ' ', results[i].transactions);
+    }
+    printf("%-24s %12.1f\n", "all stages", total);
+    printf("n: nominal, from the stage's buffer sizes, not measured\n");
+  }
+
+  return 0;
+}
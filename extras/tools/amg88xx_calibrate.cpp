@@ -0,0 +1,151 @@
+/***************************************************************************
+  Host tool that derives AMG88xx_Calibration tables from flat-field
+  captures.
+
+  Point the sensor at a uniform surface (a sheet of card or the inside of a
+  box), capture a few seconds of frames with the pixels_test example and
+  save the serial output to a file. For a two-point calibration repeat with
+  a second, warmer surface.
+
+    g++ -O2 -o amg88xx_calibrate amg88xx_calibrate.cpp
+    ./amg88xx_calibrate cold.txt [hot.txt] > calibration.h
+
+  With one capture only the offsets are corrected. With two, each pixel also
+  gets a gain so that it matches the array mean at both temperatures.
+
+  The input is read as pixels_test prints it: each frame is a [ ] block of
+  64 temperatures in degrees Celsius. Text outside the blocks, such as the
+  banner, is ignored, and blocks that do not hold exactly 64 numbers are
+  skipped.
+ ***************************************************************************/
+
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PIXELS 64
+#define PIXEL_TEMP_CONVERSION .25
+#define GAIN_SHIFT 14
+
+// average all complete frames in a capture, in raw counts
+static bool loadCapture(const char *path, double *mean) {
+  FILE *f = fopen(path, "r");
+  if (!f) {
+    fprintf(stderr, "cannot open %s\n", path);
+    return false;
+  }
+
+  double frame[PIXELS];
+  long frames = 0, damaged = 0;
+  int pixel = -1; // outside a [ ] block
+  char token[32];
+  size_t len = 0;
+  int c;
+
+  for (int i = 0; i < PIXELS; i++)
+    mean[i] = 0;
+
+  do {
+    c = fgetc(f);
+    if (c != EOF && c != '[' && c != ']' && c != ',' && !isspace(c)) {
+      if (len < sizeof(token) - 1)
+        token[len++] = c;
+      continue;
+    }
+
+    // a token ended; inside a frame it must be a standalone number
+    if (len && pixel >= 0) {
+      token[len] = 0;
+      char *end;
+      double v = strtod(token, &end);
+      if (*end || pixel >= PIXELS)
+        pixel = PIXELS + 1; // damaged, dropped at the ]
+      else
+        frame[pixel++] = v / PIXEL_TEMP_CONVERSION;
+    }
+    len = 0;
+
+    if (c == '[') {
+      if (pixel >= 0)
+        damaged++; // the last frame never closed
+      pixel = 0;
+    } else if (c == ']' && pixel >= 0) {
+      if (pixel == PIXELS) {
+        for (int i = 0; i < PIXELS; i++)
+          mean[i] += frame[i];
+        frames++;
+      } else {
+        damaged++;
+      }
+      pixel = -1;
+    }
+  } while (c != EOF);
+  fclose(f);
+
+  if (frames == 0) {
+    fprintf(stderr, "%s does not contain a full frame\n", path);
+    return false;
+  }
+
+  for (int i = 0; i < PIXELS; i++)
+    mean[i] /= frames;
+  fprintf(stderr, "%s: %ld frames, %ld damaged frames skipped\n", path,
+          frames, damaged);
+  return true;
+}
+
+static double arrayMean(const double *v) {
+  double sum = 0;
+  for (int i = 0; i < PIXELS; i++)
+    sum += v[i];
+  return sum / PIXELS;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 3) {
+    fprintf(stderr, "usage: %s cold.txt [hot.txt]\n", argv[0]);
+    return 1;
+  }
+
+  double cold[PIXELS], hot[PIXELS];
+  if (!loadCapture(argv[1], cold))
+    return 1;
+  if (argc == 3 && !loadCapture(argv[2], hot))
+    return 1;
+
+  double coldMean = arrayMean(cold);
+  double hotMean = argc == 3 ? arrayMean(hot) : 0;
+
+  long offset[PIXELS], gain[PIXELS];
+  for (int i = 0; i < PIXELS; i++) {
+    double g = 1;
+    if (argc == 3) {
+      double span = hot[i] - cold[i];
+      if (fabs(span) < 1) {
+        fprintf(stderr, "pixel %d barely changed between captures\n", i);
+        return 1;
+      }
+      g = (hotMean - coldMean) / span;
+    }
+    // (cold - offset) * gain == coldMean
+    offset[i] = lround(cold[i] - coldMean / g);
+    gain[i] = lround(g * (1 << GAIN_SHIFT));
+    if (gain[i] < 0 || gain[i] > 0xFFFF) {
+      fprintf(stderr, "pixel %d gain %f is out of range\n", i, g);
+      return 1;
+    }
+  }
+
+  printf("// generated by amg88xx_calibrate from %s%s%s\n", argv[1],
+         argc == 3 ? " and " : "", argc == 3 ? argv[2] : "");
+  printf("const AMG88xx_Calibration amgCalibration = {\n  {");
+  for (int i = 0; i < PIXELS; i++)
+    printf("%s%ld", i % 8 ? ", " : (i ? ",\n   " : ""), offset[i]);
+  printf("},\n  {");
+  for (int i = 0; i < PIXELS; i++)
+    printf("%s%ld", i % 8 ? ", " : (i ? ",\n   " : ""), gain[i]);
+  printf("}};\n");
+
+  return 0;
+}
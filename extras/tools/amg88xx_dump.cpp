@@ -0,0 +1,100 @@
+/***************************************************************************
+  Host tool that prints binary frames as text, one line per frame.
+
+  From a recording: timestamp, sequence, thermistor and the 64 pixels in
+  degrees C.
+
+    g++ -O2 -I../.. -o amg88xx_dump amg88xx_dump.cpp ../../Adafruit_AMG88xx*.cpp
+    ./amg88xx_dump capture.amg [from_ms [to_ms]] > capture.csv
+
+  From a packet stream, such as a serial port or a file captured from one:
+  sensor, sequence, thermistor and the 64 pixels in degrees C. Any number
+  of sensors may share the stream. Lost and damaged packets are reported
+  at the end.
+
+    ./amg88xx_dump --stream /dev/ttyACM0 > capture.csv
+ ***************************************************************************/
+
+#include "Adafruit_AMG88xx_Replay.h"
+#include "Adafruit_AMG88xx_Sink.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// prints each frame as one line, led by sensor or timestamp
+class PrintSink : public AMG88xx_FrameSink {
+public:
+  PrintSink(bool stream) : _stream(stream) {}
+
+  void frame(const AMG88xx_FrameView &view) {
+    printf("%u,%u", (unsigned)(_stream ? view.sensor : view.timestamp),
+           (unsigned)view.sequence);
+    printf(",%.4f", view.raw->thermistorRaw() * AMG88xx_THERMISTOR_CONVERSION);
+    for (uint8_t i = 0; i < AMG88xx_PIXEL_ARRAY_SIZE; i++)
+      printf(",%.2f", view.raw->pixel(i) * AMG88xx_PIXEL_TEMP_CONVERSION);
+    printf("\n");
+  }
+
+private:
+  bool _stream;
+};
+
+static int dumpStream(const char *path) {
+  FILE *f = strcmp(path, "-") ? fopen(path, "rb") : stdin;
+  if (!f) {
+    fprintf(stderr, "cannot open %s\n", path);
+    return 1;
+  }
+
+  PrintSink sink(true);
+  AMG88xx_StreamParser parser(&sink);
+  static uint8_t buf[65536];
+  size_t n;
+  // a serial port returns whatever has arrived, so frames print promptly
+  while ((n = fread(buf, 1, f == stdin ? 1 : sizeof(buf), f)) > 0) {
+    if (parser.parse(buf, n))
+      fflush(stdout);
+  }
+  if (f != stdin)
+    fclose(f);
+
+  fprintf(stderr, "%lu frames from %u sensors, %lu lost, %lu damaged\n",
+          (unsigned long)parser.packets(), parser.sensors(),
+          (unsigned long)parser.lost(), (unsigned long)parser.errors());
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc == 3 && !strcmp(argv[1], "--stream"))
+    return dumpStream(argv[2]);
+
+  if (argc < 2 || argc > 4) {
+    fprintf(stderr,
+            "usage: %s capture.amg [from_ms [to_ms]]\n"
+            "       %s --stream path|-\n",
+            argv[0], argv[0]);
+    return 1;
+  }
+
+  AMG88xx_RecordingFile file;
+  if (!file.open(argv[1])) {
+    fprintf(stderr, "cannot read %s as a recording\n", argv[1]);
+    return 1;
+  }
+  const AMG88xx_RecordingReader &reader = *file.reader();
+
+  const AMG88xx_RecordingHeader *h = reader.header();
+  fprintf(stderr, "%s: %u frames%s, address 0x%02x, %s FPS%s\n", argv[1],
+          (unsigned)reader.frames(), reader.indexed() ? " (indexed)" : "",
+          h->address, h->frameRate == AMG88xx_FPS_1 ? "1" : "10",
+          h->movingAverage ? ", moving average" : "");
+
+  uint32_t from = argc > 2 ? reader.find(strtoul(argv[2], NULL, 0)) : 0;
+  uint32_t to = argc > 3 ? reader.find(strtoul(argv[3], NULL, 0) + 1)
+                         : reader.frames();
+
+  PrintSink sink(false);
+  AMG88xx_readRecording(reader, &sink, 0, from, to);
+  return 0;
+}
@@ -0,0 +1,160 @@
+/***************************************************************************
+  Host tool reporting the worst case stack use of every driver function,
+  from the call graphs GCC writes with -fcallgraph-info=su.
+
+  Built as below, it reports on itself: it instantiates the driver, so the
+  call graphs of this file and the library cover the whole read path.
+
+    g++ -O2 -fcallgraph-info=su -I../.. -o amg88xx_stack amg88xx_stack.cpp \
+        ../../Adafruit_AMG88xx*.cpp
+    ./amg88xx_stack *.ci
+
+  For a target's numbers, add -fcallgraph-info=su to the target build and
+  pass its .ci files instead. Each line gives the function's own frame and
+  the deepest chain below it. Calls into code without a call graph, such as
+  the Wire library, are marked + and not counted. Runtime sized frames
+  (VLAs, alloca) and recursion have no bound; they are reported and make
+  the tool exit with status 1.
+ ***************************************************************************/
+
+#include "Adafruit_AMG88xx.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+template class Adafruit_AMG88xx_Driver<AMG88xx_I2CDeviceBus>;
+
+struct Function {
+  std::string name;
+  long frame = -1; // -1 without a call graph
+  bool dynamic = false;
+  std::vector<std::string> calls;
+
+  // filled in by walk()
+  int state = 0; // 0 unseen, 1 on the path, 2 done
+  long worst = 0;
+  bool unbounded = false;
+  bool external = false;
+};
+
+static std::map<std::string, Function> functions;
+
+static bool byName(const Function *a, const Function *b) {
+  return a->name < b->name;
+}
+
+// the text of a quoted field such as title: "..."
+static std::string field(const char *line, const char *key) {
+  const char *p = strstr(line, key);
+  if (!p)
+    return "";
+  p += strlen(key);
+  std::string value;
+  // escapes such as \n are kept as they are
+  for (; *p && *p != '"'; p++) {
+    if (*p == '\\' && p[1])
+      value += *p++;
+    value += *p;
+  }
+  return value;
+}
+
+// symbols defined in a unit are titled "unit.cpp:symbol", calls to other
+// units just "symbol"
+static std::string symbol(const std::string &title) {
+  size_t colon = title.rfind(':');
+  return colon == std::string::npos ? title : title.substr(colon + 1);
+}
+
+static bool load(const char *path) {
+  FILE *f = fopen(path, "r");
+  if (!f)
+    return false;
+  char line[4096];
+  while (fgets(line, sizeof(line), f)) {
+    if (!strncmp(line, "node:", 5)) {
+      Function &fn = functions[symbol(field(line, "title: \""))];
+      std::string label = field(line, "label: \"");
+      fn.name = label.substr(0, label.find("\\n"));
+      size_t bytes = label.rfind("\\n");
+      if (bytes != std::string::npos &&
+          label.find(" bytes (", bytes) != std::string::npos) {
+        fn.frame = atol(label.c_str() + bytes + 2);
+        fn.dynamic = label.find("dynamic", bytes) != std::string::npos;
+      }
+    } else if (!strncmp(line, "edge:", 5)) {
+      functions[symbol(field(line, "sourcename: \""))].calls.push_back(
+          symbol(field(line, "targetname: \"")));
+    }
+  }
+  fclose(f);
+  return true;
+}
+
+static void walk(Function &fn) {
+  if (fn.state == 2)
+    return;
+  if (fn.state == 1) {
+    fn.unbounded = true; // recursion
+    return;
+  }
+  fn.state = 1;
+  fn.external = fn.frame < 0;
+  fn.unbounded = fn.dynamic;
+  long deepest = 0;
+  for (size_t i = 0; i < fn.calls.size(); i++) {
+    Function &callee = functions[fn.calls[i]];
+    walk(callee);
+    if (callee.state == 1)
+      fn.unbounded = true;
+    fn.unbounded |= callee.unbounded;
+    fn.external |= callee.external;
+    if (callee.worst > deepest)
+      deepest = callee.worst;
+  }
+  fn.worst = (fn.frame > 0 ? fn.frame : 0) + deepest;
+  fn.state = 2;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s file.ci...\n", argv[0]);
+    return 1;
+  }
+  for (int i = 1; i < argc; i++) {
+    if (!load(argv[i])) {
+      fprintf(stderr, "cannot read %s\n", argv[i]);
+      return 1;
+    }
+  }
+
+  std::vector<Function *> report;
+  for (std::map<std::string, Function>::iterator it = functions.begin();
+       it != functions.end(); ++it) {
+    walk(it->second);
+    if (it->second.frame >= 0 &&
+        it->second.name.find("AMG88xx") != std::string::npos)
+      report.push_back(&it->second);
+  }
+
+  std::sort(report.begin(), report.end(), byName);
+  bool bounded = true;
+  printf("%8s %8s  %s\n", "frame", "worst", "function");
+  for (size_t i = 0; i < report.size(); i++) {
+    Function &fn = *report[i];
+    if (fn.unbounded) {
+      printf("%8ld %8s  %s\n", fn.frame, "none", fn.name.c_str());
+      bounded = false;
+    } else {
+      printf("%8ld %7ld%c  %s\n", fn.frame, fn.worst,
+             fn.external ? '+' : ' ', fn.name.c_str());
+    }
+  }
+  return bounded ? 0 : 1;
+}